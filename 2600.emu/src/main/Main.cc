@@ -214,6 +214,34 @@ void A2600System::loadState(EmuApp &, IG::CStringView path)
 	updateSwitchValues();
 }
 
+size_t A2600System::stateSize()
+{
+	Serializer state;
+	if(!osystem.state().saveState(state))
+		return 0;
+	return state.position();
+}
+
+size_t A2600System::writeState(std::span<uint8_t> buff)
+{
+	Serializer state{buff};
+	if(!osystem.state().saveState(state))
+	{
+		throwFileWriteError();
+	}
+	return state.position();
+}
+
+void A2600System::readState(std::span<const uint8_t> buff)
+{
+	Serializer state{{const_cast<uint8_t*>(buff.data()), buff.size()}}; // buffer is only read from
+	if(!osystem.state().loadState(state))
+	{
+		throwFileReadError();
+	}
+	updateSwitchValues();
+}
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
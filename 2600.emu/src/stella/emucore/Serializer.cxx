@@ -20,6 +20,7 @@
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/io/IOStream.hh>
 #include <imagine/io/FileIO.hh>
+#include <imagine/io/MapIO.hh>
 #include <emuframework/EmuApp.hh>
 
 using std::ios;
@@ -73,6 +74,13 @@ Serializer::Serializer()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(std::span<uint8_t> buffer)
+  : myStream{make_unique<IG::IOStream<IG::MapIO>>(IG::MapIO{buffer})}
+{
+  myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::setPosition(size_t pos)
 {
@@ -101,6 +109,12 @@ size_t Serializer::size()
   return s;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t Serializer::position()
+{
+  return myStream->tellp();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
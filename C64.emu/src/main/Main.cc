@@ -261,6 +261,19 @@ static void saveSnapshotTrap(uint16_t, void *data)
 		snapData->hasError = false;
 }
 
+static void writeMemSnapshotTrap(uint16_t, void *data)
+{
+	// ROMs and disks aren't included to keep the snapshot small
+	auto snapData = (SnapshotTrapData*)data;
+	snapData->hasError = snapData->plugin.machine_write_snapshot(snapData->pathStr, 0, 0, 0) < 0;
+}
+
+static void readMemSnapshotTrap(uint16_t, void *data)
+{
+	auto snapData = (SnapshotTrapData*)data;
+	snapData->hasError = snapData->plugin.machine_read_snapshot(snapData->pathStr, 0) < 0;
+}
+
 void C64System::saveState(IG::CStringView path)
 {
 	SnapshotTrapData data{.plugin{plugin}, .pathStr{path}};
@@ -286,6 +299,38 @@ void C64System::loadState(EmuApp &, IG::CStringView path)
 		return throwFileReadError();
 }
 
+size_t C64System::stateSize()
+{
+	memSnapshot.buff = {};
+	SnapshotTrapData data{.plugin{plugin}, .pathStr{MemSnapshotFile::path.data()}};
+	execC64Trap(writeMemSnapshotTrap, (void*)&data);
+	if(data.hasError)
+		return 0;
+	return memSnapshot.size;
+}
+
+size_t C64System::writeState(std::span<uint8_t> buff)
+{
+	memSnapshot.buff = buff;
+	SnapshotTrapData data{.plugin{plugin}, .pathStr{MemSnapshotFile::path.data()}};
+	execC64Trap(writeMemSnapshotTrap, (void*)&data);
+	memSnapshot.buff = {};
+	if(data.hasError)
+		throwFileWriteError();
+	return memSnapshot.size;
+}
+
+void C64System::readState(std::span<const uint8_t> buff)
+{
+	memSnapshot.buff = {const_cast<uint8_t*>(buff.data()), buff.size()}; // buffer is only read from
+	memSnapshot.size = buff.size();
+	SnapshotTrapData data{.plugin{plugin}, .pathStr{MemSnapshotFile::path.data()}};
+	execC64Trap(readMemSnapshotTrap, (void*)&data);
+	memSnapshot.buff = {};
+	if(data.hasError)
+		throwFileReadError();
+}
+
 VideoSystem C64System::videoSystem() const
 {
 	switch(intResource("MachineVideoStandard"))
@@ -477,6 +522,29 @@ void C64System::execC64Frame()
 	execDoneSem.acquire();
 }
 
+void C64System::execC64Trap(void (*trapFunc)(uint16_t, void *), void *data)
+{
+	// run the C64 thread only until the trap executes so no extra frame is emulated
+	struct TrapData
+	{
+		C64System &sys;
+		void (*func)(uint16_t, void *);
+		void *data;
+	};
+	TrapData trapData{*this, trapFunc, data};
+	plugin.interrupt_maincpu_trigger_trap(
+		[](uint16_t pc, void *data)
+		{
+			auto &trapData = *(TrapData*)data;
+			trapData.func(pc, trapData.data);
+			// pause the C64 thread until the next frame is requested
+			trapData.sys.execDoneSem.release();
+			trapData.sys.execSem.acquire();
+		}, (void*)&trapData);
+	execSem.release();
+	execDoneSem.acquire();
+}
+
 void C64System::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	audioPtr = audio;
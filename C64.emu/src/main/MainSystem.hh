@@ -25,6 +25,8 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <span>
+#include <cstdio>
 
 extern "C"
 {
@@ -81,6 +83,22 @@ bool hasC64TapeExtension(std::string_view name);
 bool hasC64CartExtension(std::string_view name);
 int systemCartType(ViceSystem system);
 
+// Memory-backed file used for snapshots by the memory save state functions,
+// opened by VICE through zfile_fopen() with the special path name,
+// a null buffer only counts the bytes written
+struct MemSnapshotFile
+{
+	static constexpr std::string_view path{":memsnapshot:"};
+	std::span<uint8_t> buff{};
+	size_t pos{};
+	size_t size{};
+
+	FILE *open(const char *mode);
+	ssize_t read(char *buf, size_t bytes);
+	ssize_t write(const char *buf, size_t bytes);
+	off_t seek(off_t offset, int whence);
+};
+
 class C64System final: public EmuSystem
 {
 public:
@@ -94,6 +112,7 @@ public:
 	IG::PixmapView canvasSrcPix{};
 	PixelFormat pixFmt{};
 	ViceSystem currSystem{};
+	MemSnapshotFile memSnapshot{};
 	std::atomic_bool runningFrame{};
 	bool ctrlLock{};
 	bool c64IsInit{}, c64FailedInit{};
@@ -195,6 +214,9 @@ public:
 	std::string_view stateFilenameExt() const { return ".vsf"; }
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &io, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
@@ -231,6 +253,7 @@ protected:
 	void setModel(int model);
 	void applyInitialOptionResources();
 	void execC64Frame();
+	void execC64Trap(void (*trapFunc)(uint16_t, void *), void *data);
 	void startCanvasRunningFrame();
 	void setCanvasSkipFrame(bool on);
 	bool updateCanvasPixelFormat(struct video_canvas_s *, PixelFormat);
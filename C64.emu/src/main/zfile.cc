@@ -20,6 +20,8 @@
 #include <emuframework/EmuApp.hh>
 #include <emuframework/FilePicker.hh>
 #include "MainSystem.hh"
+#include <algorithm>
+#include <cstring>
 
 extern "C"
 {
@@ -30,6 +32,10 @@ using namespace EmuEx;
 
 CLINK FILE *zfile_fopen(const char *path, const char *mode)
 {
+	if(path == MemSnapshotFile::path)
+	{
+		return gC64System().memSnapshot.open(mode);
+	}
 	auto appContext = gAppContext();
 	if(EmuApp::hasArchiveExtension(appContext.fileUriDisplayName(path)))
 	{
@@ -65,3 +71,96 @@ CLINK FILE *zfile_fopen(const char *path, const char *mode)
 		return FileUtils::fopenUri(appContext, path, mode);
 	}
 }
+
+namespace EmuEx
+{
+
+FILE *MemSnapshotFile::open(const char *mode)
+{
+	pos = 0;
+	if(std::string_view{mode}.contains('w'))
+		size = 0;
+	#if defined __ANDROID__ || __APPLE__
+	return funopen(this,
+		[](void *cookie, char *buf, int size)
+		{
+			return (int)((MemSnapshotFile*)cookie)->read(buf, size);
+		},
+		[](void *cookie, const char *buf, int size)
+		{
+			return (int)((MemSnapshotFile*)cookie)->write(buf, size);
+		},
+		[](void *cookie, fpos_t offset, int whence)
+		{
+			return (fpos_t)((MemSnapshotFile*)cookie)->seek(offset, whence);
+		},
+		[](void *) { return 0; });
+	#else
+	cookie_io_functions_t funcs
+	{
+		.read =
+			[](void *cookie, char *buf, size_t size)
+			{
+				return ((MemSnapshotFile*)cookie)->read(buf, size);
+			},
+		.write =
+			[](void *cookie, const char *buf, size_t size)
+			{
+				return ((MemSnapshotFile*)cookie)->write(buf, size);
+			},
+		.seek =
+			[](void *cookie, off64_t *position, int whence)
+			{
+				auto newPos = ((MemSnapshotFile*)cookie)->seek(*position, whence);
+				if(newPos == -1)
+					return -1;
+				*position = newPos;
+				return 0;
+			},
+		.close = [](void *) { return 0; }
+	};
+	return fopencookie(this, mode, funcs);
+	#endif
+}
+
+ssize_t MemSnapshotFile::read(char *buf, size_t bytes)
+{
+	if(pos >= size)
+		return 0;
+	bytes = std::min(bytes, size - pos);
+	memcpy(buf, buff.data() + pos, bytes);
+	pos += bytes;
+	return bytes;
+}
+
+ssize_t MemSnapshotFile::write(const char *buf, size_t bytes)
+{
+	if(buff.data())
+	{
+		if(pos >= buff.size())
+			return 0;
+		bytes = std::min(bytes, buff.size() - pos);
+		memcpy(buff.data() + pos, buf, bytes);
+	}
+	pos += bytes;
+	size = std::max(size, pos);
+	return bytes;
+}
+
+off_t MemSnapshotFile::seek(off_t offset, int whence)
+{
+	off_t newPos;
+	switch(whence)
+	{
+		case SEEK_SET: newPos = offset; break;
+		case SEEK_CUR: newPos = pos + offset; break;
+		case SEEK_END: newPos = size + offset; break;
+		default: return -1;
+	}
+	if(newPos < 0)
+		return -1;
+	pos = newPos;
+	return newPos;
+}
+
+}
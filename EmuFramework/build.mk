@@ -6,6 +6,8 @@ endif
 
 SRC += AudioOptionView.cc \
 AutosaveSlotView.cc \
+AutosaveWriter.cc \
+Benchmark.cc \
 BundledGamesView.cc \
 ButtonConfigView.cc \
 Cheats.cc \
@@ -28,16 +30,25 @@ EmuView.cc \
 EmuViewController.cc \
 FilePathOptionView.cc \
 FilePicker.cc \
+FramePacer.cc \
+FrameProfiler.cc \
 GUIOptionView.cc \
 InputManagerView.cc \
+InputRecorder.cc \
 pathUtils.cc \
 RecentGameView.cc \
+RewindManager.cc \
+ScreenshotWriter.cc \
 StateSlotView.cc \
 SystemOptionView.cc \
 VideoImageEffect.cc \
 VideoImageOverlay.cc \
 VideoOptionView.cc
 
+ifeq ($(ENV), linux)
+ SRC += BatchRunner.cc
+endif
+
 ifeq ($(emuFramework_onScreenControls), 1)
  SRC += TouchConfigView.cc \
  vcontrols/VController.cc \
@@ -69,6 +80,7 @@ CFLAGS_WARN += -Werror=implicit-fallthrough
 
 include $(IMAGINE_PATH)/make/package/imagine.mk
 include $(IMAGINE_PATH)/make/package/stdc++.mk
+include $(IMAGINE_PATH)/make/package/zlib.mk
 
 include $(IMAGINE_PATH)/make/imagineStaticLibTarget.mk
 
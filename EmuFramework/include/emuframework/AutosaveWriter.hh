@@ -0,0 +1,73 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/memory/Buffer.hh>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Writes autosave states in the background so slow storage doesn't stall emulation.
+// The state is captured into memory with EmuSystem::writeState() on the main thread,
+// then a worker thread compresses it with zlib and replaces the destination file
+// by writing to a temporary file and renaming it.
+
+class AutosaveWriter
+{
+public:
+	AutosaveWriter(ApplicationContext ctx): ctx{ctx} {}
+	~AutosaveWriter();
+	// Returns a buffer of at least size bytes to capture a state into,
+	// waiting if the worker is still compressing the previous state
+	std::span<uint8_t> stateBuffer(size_t size);
+	// Queues the first size bytes of the state buffer to be written to path
+	void write(CStringView path, size_t size);
+	// Blocks until any queued write completes
+	void wait();
+
+	static bool isStateFile(std::span<const uint8_t> data);
+	// Returns the decompressed state from the contents of a file created by write(), throwing on errors
+	static ByteBuffer decompressState(std::span<const uint8_t> data);
+
+protected:
+	ApplicationContext ctx;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cond;
+	ByteBuffer state;
+	ByteBuffer output;
+	FS::PathString path;
+	size_t size{};
+	bool hasWrite{};
+	bool isCompressing{};
+	bool isWriting{};
+	bool quit{};
+
+	void run();
+	size_t compress();
+	bool writeFile(CStringView path, std::span<const uint8_t> data) const;
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/base/BaseApplication.hh>
+#include <optional>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Options for running the content files listed in a text file, one per line, as parallel
+// worker processes in benchmark mode with frame hashing (desktop Linux only):
+// --batch=listPath [--batch-jobs=processes] [--batch-frames=frames] [--batch-output=dir]
+// [--input-script=path]
+// Each worker writes its results to <dir>/<list index>.json and its hash log to
+// <dir>/<list index>.hashes, and a summary of all runs is written to <dir>/summary.json.
+
+struct BatchParams
+{
+	FS::PathString listPath{};
+	FS::PathString outputDir{"."};
+	FS::PathString inputScriptPath{};
+	int jobs{};
+	int frames{600};
+
+	static std::optional<BatchParams> parse(CommandArgs);
+};
+
+// Returns the process exit code, non-zero if any worker failed
+int runBatch(const BatchParams &);
+
+}
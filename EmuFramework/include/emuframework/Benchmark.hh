@@ -0,0 +1,100 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/base/BaseApplication.hh>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuSystem;
+class EmuVideo;
+class EmuAudio;
+
+// Options for running a benchmark of the content given on the command line:
+// --benchmark[=frames] [--benchmark-warmup=frames] [--benchmark-output=path]
+// [--benchmark-hash] [--hash-log=path] [--input-script=path] [--input-replay=path]
+// Hashing runs a single pass with all active sinks and records a hash of every video frame
+// and of the audio samples written during it. Giving a hash log path enables hashing and
+// writes the hashes as text lines of "frame videoHash audioHash", for comparing with
+// EmuFramework/tools/compareHashLogs.sh.
+// The input script is a text file of "frame key pressed" lines, with frames counted
+// from the first warm-up frame and keys in the system's own key codes.
+// An input replay is a file written by InputRecorder, its save state is loaded before
+// each pass and its input used as the script. Replays default to no warm-up frames and
+// a frame count of the recording's length.
+// The benchmark isn't headless: video frames go through the main window's renderer, so a
+// display is needed (a virtual X server on CI hosts), though the window is never shown.
+
+struct BenchmarkParams
+{
+	int warmupFrames{120};
+	int frames{1800};
+	FS::PathString outputPath{};
+	FS::PathString inputScriptPath{};
+	FS::PathString inputReplayPath{};
+	FS::PathString hashLogPath{};
+	bool hashFrames{};
+
+	static std::optional<BenchmarkParams> parse(CommandArgs);
+};
+
+struct FrameTimeStats
+{
+	Time total{}, mean{}, median{}, p99{}, min{}, max{};
+
+	static FrameTimeStats make(std::span<const Time> frameTimes);
+};
+
+struct BenchmarkPass
+{
+	std::string_view name;
+	bool video{}, audio{};
+	std::vector<Time> frameTimes{};
+	std::vector<uint64_t> frameHashes{};
+	std::vector<uint64_t> audioHashes{};
+	FrameTimeStats stats{};
+};
+
+struct InputScriptEvent
+{
+	int frame{};
+	unsigned key{};
+	bool pressed{};
+	uint32_t metaState{};
+};
+
+std::vector<InputScriptEvent> parseInputScript(std::string_view script);
+
+// Runs the warm-up frames followed by a timed pass of the configured frame count
+// for each combination of video & audio sinks, audio passes are skipped if audio is null.
+// A non-empty start state is loaded before each pass so they all run the same frames.
+std::vector<BenchmarkPass> runBenchmark(EmuSystem &, EmuVideo &, EmuAudio *, const BenchmarkParams &,
+	std::span<const InputScriptEvent> inputScript = {}, std::span<const uint8_t> startState = {});
+std::string benchmarkResultsJson(const EmuSystem &, const BenchmarkParams &, std::span<const BenchmarkPass>);
+std::string frameHashLog(const EmuSystem &, const BenchmarkParams &, const BenchmarkPass &);
+std::string jsonEscaped(std::string_view);
+
+}
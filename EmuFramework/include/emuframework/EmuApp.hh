@@ -25,6 +25,13 @@
 #include <emuframework/EmuInput.hh>
 #include <emuframework/VController.hh>
 #include <emuframework/TurboInput.hh>
+#include <emuframework/RewindManager.hh>
+#include <emuframework/AutosaveWriter.hh>
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/FrameProfiler.hh>
+#include <emuframework/InputRecorder.hh>
+#include <emuframework/FramePacer.hh>
+#include <emuframework/Benchmark.hh>
 #include <emuframework/Option.hh>
 #include <imagine/input/Input.hh>
 #include <imagine/input/android/MogaManager.hh>
@@ -169,6 +176,7 @@ public:
 	void printScreenshotResult(bool success);
 	bool saveAutosave();
 	bool loadAutosave(LoadAutosaveMode m = LoadAutosaveMode::Normal);
+	void waitForPendingWrites();
 	bool setAutosave(std::string_view name);
 	bool renameAutosave(std::string_view name, std::string_view newName);
 	bool deleteAutosave(std::string_view name);
@@ -201,6 +209,7 @@ public:
 	void removeTurboInputEvent(unsigned action);
 	void removeTurboInputEvents() { turboActions = {}; }
 	void runTurboInputEvents();
+	void handleSystemInput(InputAction);
 	void resetInput();
 	void setRunSpeed(double speed);
 	void saveSessionOptions();
@@ -236,12 +245,18 @@ public:
 	void runFrames(EmuSystemTaskContext, EmuVideo *, EmuAudio *, int frames, bool skipForward);
 	void skipFrames(EmuSystemTaskContext, int frames, EmuAudio *);
 	bool skipForwardFrames(EmuSystemTaskContext, int frames);
+	void setRewindBufferSizeMB(uint8_t mb);
+	void setRewindInterval(uint8_t frames);
+	bool rewindIsEnabled() const;
+	void setRewinding(bool on);
+	void setRunAheadFrames(uint8_t frames);
 	FloatSeconds bestFrameTimeForScreen(VideoSystem system) const;
 	void applyFrameRates(bool updateFrameTime = true);
 	IG::Audio::Manager &audioManager() { return audioManager_; }
 	void renderSystemFramebuffer(EmuVideo &);
-	bool writeScreenshot(IG::PixmapView, IG::CStringView path);
-	FS::PathString makeNextScreenshotFilename();
+	void queueScreenshot(IG::PixmapView);
+	FS::PathString makeNextScreenshotFilename(std::string_view extension = ".png");
+	IG::Data::PixmapWriteParams screenshotWriteParams() const;
 	bool mogaManagerIsActive() const;
 	void setMogaManagerActive(bool on, bool notify);
 	constexpr IG::VibrationManager &vibrationManager() { return vibrationManager_; }
@@ -265,6 +280,7 @@ public:
 	double intendedFrameRate(const IG::Window &) const;
 	static std::u16string_view mainViewName();
 	void runBenchmarkOneShot(EmuVideo &);
+	void runBenchmarkFromCommandLine(IG::CStringView path);
 	void onSelectFileFromPicker(IG::IO, IG::CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams);
 	void handleOpenFileCommand(IG::CStringView path);
@@ -290,6 +306,8 @@ public:
 	bool soundIsEnabled() const;
 	void setAddSoundBuffersOnUnderrun(bool on);
 	bool addSoundBuffersOnUnderrun() const { return optionAddSoundBuffersOnUnderrun; }
+	void setDynamicRateControl(bool on);
+	bool dynamicRateControl() const { return optionDynamicRateControl; }
 	void setSoundDuringFastSlowModeEnabled(bool on);
 	bool soundDuringFastSlowModeIsEnabled() const;
 
@@ -315,6 +333,9 @@ public:
 	int frameInterval() const;
 	void setShouldSkipLateFrames(bool on) { optionSkipLateFrames = on; }
 	bool shouldSkipLateFrames() const { return optionSkipLateFrames; }
+	void setLowLatencyFramePacing(bool on);
+	bool lowLatencyFramePacing() const { return optionLowLatencyFramePacing; }
+	FramePacer &framePacer() { return framePacer_; }
 	bool setVideoZoom(uint8_t val);
 	uint8_t videoZoom() const { return optionImageZoom; }
 	bool setViewportZoom(uint8_t val);
@@ -322,6 +343,7 @@ public:
 	auto &showOnSecondScreenOption() { return optionShowOnSecondScreen; }
 	auto &textureBufferModeOption() { return optionTextureBufferMode; }
 	auto &videoImageBuffersOption() { return optionVideoImageBuffers; }
+	auto &skipUnchangedVideoRowsOption() { return optionSkipUnchangedVideoRows; }
 	void setUsePresentationTime(bool on) { usePresentationTime_ = on; }
 	bool usePresentationTime() const { return usePresentationTime_; }
 	void setContentRotation(IG::Rotation);
@@ -336,7 +358,18 @@ public:
 	// System Options
 	auto &autosaveTimerMinsOption() { return optionAutosaveTimerMins; }
 	auto &confirmOverwriteStateOption() { return optionConfirmOverwriteState; }
+	auto &cacheExtractedContentOption() { return optionCacheExtractedContent; }
+	auto &screenshotFormatOption() { return optionScreenshotFormat; }
+	FrameProfiler &frameProfiler() { return frameProfiler_; }
+	bool exportFrameTimeTrace();
+	InputRecorder &inputRecorder() { return inputRecorder_; }
+	bool startInputRecording();
+	bool stopInputRecording();
+	void cancelInputRecording(std::string_view reason);
 	auto &fastSlowModeSpeedOption() { return optionFastSlowModeSpeed; }
+	auto &rewindBufferSizeOption() { return optionRewindBufferSize; }
+	auto &rewindIntervalOption() { return optionRewindInterval; }
+	auto &runAheadFramesOption() { return optionRunAheadFrames; }
 	double fastSlowModeSpeedAsDouble() { return optionFastSlowModeSpeed.val / 100.; }
 	auto &sustainedPerformanceModeOption() { return optionSustainedPerformanceMode; }
 
@@ -500,17 +533,26 @@ protected:
 	mutable Gfx::Texture assetBuffImg[wise_enum::size<AssetID>];
 	VController vController;
 	IG::Timer autoSaveTimer;
+	IG::Timer framePacingTimer;
+	IG::FrameTime pacedFramePresentTime{};
 	IG::Time autoSaveTimerStartTime{};
 	IG::Time autoSaveTimerElapsedTime{};
+	AutosaveWriter autosaveWriter;
 	DelegateFunc<void ()> onUpdateInputDevices_;
 	OnMainMenuOptionChanged onMainMenuOptionChanged_;
 	KeyConfigContainer customKeyConfigs;
 	InputDeviceSavedConfigContainer savedInputDevs;
 	TurboInput turboActions;
+	RewindManager rewindManager;
+	FrameProfiler frameProfiler_;
+	InputRecorder inputRecorder_;
+	FramePacer framePacer_;
+	IG::ByteBuffer runAheadState;
 	Gfx::Vec3 videoBrightnessRGB{1.f, 1.f, 1.f};
 	FS::PathString contentSearchPath_;
 	[[no_unique_address]] IG::Data::PixmapReader pixmapReader;
 	[[no_unique_address]] IG::Data::PixmapWriter pixmapWriter;
+	ScreenshotWriter screenshotWriter;
 	[[no_unique_address]] IG::VibrationManager vibrationManager_;
 	BluetoothAdapter *bta{};
 	IG_UseMemberIf(MOGA_INPUT, std::unique_ptr<Input::MogaManager>, mogaManagerPtr);
@@ -526,10 +568,16 @@ protected:
 	Byte1Option optionAutosaveTimerMins;
 	Byte1Option optionConfirmOverwriteState;
 	Byte2Option optionFastSlowModeSpeed;
+	Byte1Option optionRewindBufferSize;
+	Byte1Option optionRewindInterval;
+	Byte1Option optionRunAheadFrames;
 	Byte1Option optionSound;
 	Byte1Option optionSoundVolume;
 	Byte1Option optionSoundBuffers;
 	Byte1Option optionAddSoundBuffersOnUnderrun;
+	Byte1Option optionDynamicRateControl;
+	Byte1Option optionCacheExtractedContent;
+	Byte1Option optionScreenshotFormat;
 	IG_UseMemberIf(IG::Audio::Config::MULTIPLE_SYSTEM_APIS, Byte1Option, optionAudioAPI);
 	Byte1Option optionNotificationIcon;
 	Byte1Option optionTitleBar;
@@ -552,11 +600,13 @@ protected:
 	Byte1Option optionOverlayEffectLevel;
 	IG_UseMemberIf(Config::SCREEN_FRAME_INTERVAL, Byte1Option, optionFrameInterval);
 	Byte1Option optionSkipLateFrames;
+	Byte1Option optionLowLatencyFramePacing;
 	Byte1Option optionImageZoom;
 	Byte1Option optionViewportZoom;
 	Byte1Option optionShowOnSecondScreen;
 	Byte1Option optionTextureBufferMode;
 	Byte1Option optionVideoImageBuffers;
+	Byte1Option optionSkipUnchangedVideoRows;
 	Gfx::DrawableConfig windowDrawableConf;
 	IG::PixelFormat renderPixelFmt;
 	IG::Rotation contentRotation_{IG::Rotation::ANY};
@@ -565,6 +615,9 @@ protected:
 	IG::WindowFrameTimeSource winFrameTimeSrc{IG::WindowFrameTimeSource::AUTO};
 	IG_UseMemberIf(Config::envIsAndroid, bool, usePresentationTime_){true};
 	IG_UseMemberIf(Config::envIsAndroid, bool, forceMaxScreenFrameRate){};
+	bool isRewinding{};
+	bool runAheadUnsupported{};
+	std::optional<BenchmarkParams> benchmarkParams;
 public:
 	AutosaveLaunchMode autosaveLaunchMode{};
 
@@ -608,6 +661,13 @@ protected:
 	std::optional<Gfx::ColorSpace> windowDrawableColorSpaceOption() const;
 	FS::PathString sessionConfigPath();
 	void loadSystemOptions();
+	void applyRewindOptions();
+	bool saveAutosaveState(IG::CStringView path);
+	bool loadAutosaveState(IG::CStringView path);
+	void runFrameAhead(EmuSystemTaskContext, EmuVideo *, EmuAudio *);
+	void runSyncedFrame(IG::FrameTime presentTime);
+	void schedulePacedFrame(IG::FrameParams);
+	void runPacedFrame();
 	void saveSystemOptions();
 	void saveSystemOptions(FileIO &);
 	bool allWindowsAreFocused() const;
@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/audio/OutputStream.hh>
+#include <imagine/audio/Resampler.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/vmem/RingBuffer.hh>
 #include <memory>
@@ -47,15 +48,21 @@ public:
 	void setStereo(bool on);
 	void setSpeedMultiplier(double speed);
 	void setAddSoundBuffersOnUnderrun(bool on);
+	void setDynamicRateControl(bool on);
+	void setHashFrames(bool on);
+	uint64_t takeFrameHash();
 	void setVolume(int8_t vol);
 	IG::Audio::Format format() const;
+	float bufferFill() const;
 	explicit operator bool() const;
 
 protected:
 	IG::Audio::OutputStream audioStream;
 	const IG::Audio::Manager *audioManagerPtr{};
 	IG::RingBuffer rBuff;
+	IG::Audio::Resampler resampler;
 	IG::Time lastUnderrunTime{};
+	uint64_t frameHash{};
 	double speedMultiplier = 1.;
 	size_t targetBufferFillBytes{};
 	size_t bufferIncrementBytes{};
@@ -64,12 +71,15 @@ protected:
 	float requestedVolume = 1.0;
 	std::atomic<AudioWriteState> audioWriteState = AudioWriteState::BUFFER;
 	bool addSoundBuffersOnUnderrun = false;
+	bool dynamicRateControl = false;
+	bool hashFrames = false;
 	int8_t channels = 2;
 
 	size_t framesFree() const;
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
+	double resampleStep() const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
 	const IG::Audio::Manager &audioManager() const;
 };
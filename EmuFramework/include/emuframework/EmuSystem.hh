@@ -24,6 +24,7 @@
 #include <emuframework/EmuTiming.hh>
 #include <emuframework/VController.hh>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -171,8 +172,9 @@ public:
 	[[gnu::hot]] void runFrame(EmuSystemTaskContext task, EmuVideo *video, EmuAudio *audio);
 	FS::FileString stateFilename(int slot, std::string_view name) const;
 	std::string_view stateFilenameExt() const;
-	void loadState(EmuApp &, CStringView uri);
-	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &io, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
@@ -208,6 +210,8 @@ public:
 	bool shouldFastForward() const;
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	IG::Rotation contentRotation() const;
+	void loadState(EmuApp &, CStringView uri);
+	void saveState(CStringView path);
 
 	ApplicationContext appContext() const { return appCtx; }
 	bool isActive() const { return state == State::ACTIVE; }
@@ -233,6 +237,8 @@ public:
 	std::string contentDisplayName() const;
 	void setContentDisplayName(std::string_view name);
 	FS::FileString contentDisplayNameForPathDefaultImpl(IG::CStringView path) const;
+	void loadStateDefaultImpl(CStringView uri);
+	void saveStateDefaultImpl(CStringView path);
 	void setInitialLoadPath(IG::CStringView path);
 	FS::PathString fallbackSaveDirectory(bool create = false);
 	const auto &contentSaveDirectory() const { return contentSaveDirectory_; }
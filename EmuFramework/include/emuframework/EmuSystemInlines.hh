@@ -201,12 +201,33 @@ void EmuSystem::runFrame(EmuSystemTaskContext task, EmuVideo *video, EmuAudio *a
 
 void EmuSystem::loadState(EmuApp &app, IG::CStringView uri)
 {
-	static_cast<MainSystem*>(this)->loadState(app, uri);
+	if(&MainSystem::loadState != &EmuSystem::loadState)
+		static_cast<MainSystem*>(this)->loadState(app, uri);
+	else
+		loadStateDefaultImpl(uri);
 }
 
 void EmuSystem::saveState(IG::CStringView uri)
 {
-	static_cast<MainSystem*>(this)->saveState(uri);
+	if(&MainSystem::saveState != &EmuSystem::saveState)
+		static_cast<MainSystem*>(this)->saveState(uri);
+	else
+		saveStateDefaultImpl(uri);
+}
+
+size_t EmuSystem::stateSize()
+{
+	return static_cast<MainSystem*>(this)->stateSize();
+}
+
+size_t EmuSystem::writeState(std::span<uint8_t> buff)
+{
+	return static_cast<MainSystem*>(this)->writeState(buff);
+}
+
+void EmuSystem::readState(std::span<const uint8_t> buff)
+{
+	static_cast<MainSystem*>(this)->readState(buff);
 }
 
 void EmuSystem::clearInputBuffers(EmuInputView &view)
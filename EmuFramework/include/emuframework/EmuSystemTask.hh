@@ -67,13 +67,14 @@ public:
 	void runFrame(EmuVideo *video, EmuAudio *audio, int8_t frames, bool skipForward, bool runSync);
 	void sendVideoFormatChangedReply(EmuVideo &video, std::binary_semaphore *frameFinishedSemPtr);
 	void sendFrameFinishedReply(EmuVideo &video, std::binary_semaphore *frameFinishedSemPtr);
-	void sendScreenshotReply(bool success);
 	EmuApp &app() const;
 	bool resetVideoFormatChanged() { return std::exchange(videoFormatChanged, false); }
 
 private:
+	// briefly spin before parking since frames are usually requested back to back when catching up
+	static constexpr int commandSpinCount = 1000;
 	EmuApp *appPtr{};
-	IG::MessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
+	IG::SPSCMessagePort<CommandMessage> commandPort{commandSpinCount};
 	std::thread taskThread;
 	bool videoFormatChanged{};
 };
@@ -21,6 +21,7 @@
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
 #include <optional>
+#include <vector>
 
 namespace EmuEx
 {
@@ -69,6 +70,10 @@ public:
 	bool addFence(Gfx::RendererCommands &cmds);
 	void clear();
 	void takeGameScreenshot();
+	void setHashFrames(bool on);
+	void setSkipUnchangedRows(bool on);
+	bool skipsUnchangedRows() const { return skipUnchangedRows; }
+	uint64_t frameHash() const { return lastFrameHash; }
 	bool isExternalTexture() const;
 	Gfx::PixmapBufferTexture &image();
 	Gfx::Renderer &renderer() const;
@@ -95,7 +100,11 @@ protected:
 	FormatChangedDelegate onFormatChanged;
 	IG::PixelFormat renderFmt;
 	Gfx::TextureBufferMode bufferMode{};
+	uint64_t lastFrameHash{};
+	std::vector<uint64_t> rowHashes;
 	bool screenshotNextFrame{};
+	bool hashFrames{};
+	bool skipUnchangedRows{};
 	bool singleBuffer{};
 	bool needsFence{};
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
@@ -105,6 +114,8 @@ protected:
 	void postFrameFinished(EmuSystemTaskContext);
 	void syncImageAccess();
 	void updateNeedsFence();
+	std::pair<int, int> updateChangedRows(IG::PixmapView);
+	void resetChangedRows() { rowHashes.clear(); }
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
 };
 
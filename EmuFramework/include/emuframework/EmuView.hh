@@ -16,9 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/gui/View.hh>
-#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 #include <imagine/gfx/GfxText.hh>
-#endif
 
 namespace EmuEx
 {
@@ -41,6 +39,7 @@ public:
 	void setLayoutInputView(EmuInputView *view);
 	void updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
 	void clearAudioStats();
+	void updateFrameTimeStats();
 	EmuVideoLayer *videoLayer() const { return layer; }
 	EmuSystem &system() { return *sysPtr; }
 
@@ -48,6 +47,10 @@ private:
 	EmuVideoLayer *layer{};
 	EmuInputView *inputView{};
 	EmuSystem *sysPtr{};
+	Gfx::Text frameTimeStatsText{};
+	int framesUntilStatsTextUpdate{};
+
+	void drawFrameTimeStats(Gfx::RendererCommands &__restrict__);
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 	Gfx::Text audioStatsText{};
 	Gfx::GCRect audioStatsRect{};
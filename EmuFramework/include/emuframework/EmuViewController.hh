@@ -81,6 +81,7 @@ public:
 	bool drawExtraWindow(IG::Window &win, IG::WindowDrawParams, Gfx::RendererTask &);
 	void updateEmuAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
 	void clearEmuAudioStats();
+	void updateFrameTimeStats();
 	void popToSystemActionsMenu();
 	void postDrawToEmuWindows();
 	IG::Screen *emuWindowScreen() const;
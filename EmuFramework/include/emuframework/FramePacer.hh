@@ -0,0 +1,51 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <atomic>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Estimates how long emulating & drawing a frame takes so its start can be delayed
+// until just before the display deadline, letting input be sampled as late as possible.
+// The estimates rise quickly on slow frames and fall slowly, and a safety margin
+// grows each time a frame misses its deadline then decays back while frames are on time.
+// Draw times may be added from the renderer thread.
+
+class FramePacer
+{
+public:
+	static constexpr SteadyClockTime minDelay = std::chrono::milliseconds{1};
+	static constexpr SteadyClockTime minMargin = std::chrono::microseconds{1500};
+
+	SteadyClockTime startDelay(SteadyClockTime now, SteadyClockTime deadline, FloatSeconds frameTime) const;
+	void addFrame(SteadyClockTime emulateTime, SteadyClockTime readyTime, SteadyClockTime deadline);
+	void addDrawTime(SteadyClockTime);
+	void addMissedStart();
+	void reset();
+	SteadyClockTime frameCost() const;
+
+protected:
+	double emulateNs{};
+	std::atomic<double> drawNs{};
+	double marginNs{double(SteadyClockTime{minMargin}.count())};
+};
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Records where each frame's time goes so it can be shown as an on-screen graph or exported
+// as a Chrome trace (load the JSON in chrome://tracing or Perfetto). Stage times can be added
+// from any thread and are assigned to the frame begun by the last beginFrame() call.
+
+class FrameProfiler
+{
+public:
+	enum class Stat : uint8_t
+	{
+		EMULATE,    // EmuSystemTask running frames, includes UPLOAD and FENCE_WAIT
+		UPLOAD,     // writing the frame into the video texture
+		FENCE_WAIT, // waiting for the renderer to release the video texture
+		DRAW,       // drawing and presenting the main window
+	};
+
+	static constexpr size_t statCount = 4;
+	static constexpr size_t maxSamples = 1200;
+
+	struct Sample
+	{
+		SteadyClockTime timestamp{};
+		std::array<SteadyClockTime, statCount> start{};
+		std::array<SteadyClockTime, statCount> duration{};
+		int8_t framesAdvanced{};
+		uint8_t audioFillPercent{};
+
+		SteadyClockTime time(Stat s) const { return duration[size_t(s)]; }
+	};
+
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(FrameProfiler *stats, Stat stat):
+			stats{stats}, stat{stat}, start{stats ? steadyClockTimestamp() : SteadyClockTime{}} {}
+		ScopedTimer(const ScopedTimer &) = delete;
+		~ScopedTimer() { if(stats) stats->add(stat, start, steadyClockTimestamp()); }
+
+	protected:
+		FrameProfiler *stats;
+		Stat stat;
+		SteadyClockTime start;
+	};
+
+	bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+	void setEnabled(bool on);
+	// Called on the main thread each time the emulation advances, completing the previous frame's sample
+	void beginFrame(int framesAdvanced, float audioFill);
+	void add(Stat, SteadyClockTime start, SteadyClockTime end);
+	ScopedTimer time(Stat s) { return {isEnabled() ? this : nullptr, s}; }
+	void clear();
+	// Copies up to the most recent samples.size() samples into samples, oldest first, returning the count
+	size_t recentSamples(std::span<Sample> samples) const;
+	size_t size() const;
+	bool writeChromeTrace(CStringView path) const;
+
+protected:
+	mutable std::mutex mutex;
+	std::vector<Sample> samples;
+	size_t nextSampleIdx{};
+	Sample current{};
+	std::array<std::atomic<SteadyClockTime::rep>, statCount> pendingStart{};
+	std::array<std::atomic<SteadyClockTime::rep>, statCount> pendingDuration{};
+	std::atomic_bool enabled{};
+	bool hasCurrent{};
+};
+
+}
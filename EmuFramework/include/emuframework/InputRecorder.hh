@@ -0,0 +1,67 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/Benchmark.hh>
+#include <imagine/util/memory/Buffer.hh>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace EmuEx
+{
+
+class EmuSystem;
+struct InputAction;
+
+// Input captured from a memory save state onward, replayable with the benchmark runner
+// since its events are applied before the same frame indices they were recorded at.
+
+struct InputRecording
+{
+	ByteBuffer state;
+	std::vector<InputScriptEvent> events;
+	int frames{};
+
+	static InputRecording read(std::span<const uint8_t>);
+	std::vector<uint8_t> write() const;
+};
+
+// Logs handled input actions tagged with the count of frames run since recording started.
+// Actions may be recorded from both the main & emulation threads.
+
+class InputRecorder
+{
+public:
+	void start(EmuSystem &);
+	InputRecording stop();
+	void cancel();
+	void record(InputAction);
+	void onFrameStart() { if(isRecording()) frame.fetch_add(1, std::memory_order_relaxed); }
+	bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+	int frames() const { return frame.load(std::memory_order_relaxed); }
+
+protected:
+	std::mutex mutex;
+	ByteBuffer state;
+	std::vector<InputScriptEvent> events;
+	std::atomic_int frame{};
+	std::atomic_bool recording{};
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/vmem/RingBuffer.hh>
+#include <imagine/util/memory/Buffer.hh>
+#include <cstdint>
+#include <span>
+
+namespace EmuEx
+{
+
+class EmuSystem;
+
+// Keeps a history of in-memory save states for stepping emulation backwards.
+// The most recent state is stored in full while older states are stored in the
+// ring buffer as XOR deltas against their successor, run-length encoded so only
+// the changed parts of each state take up space.
+
+class RewindManager
+{
+public:
+	static constexpr size_t MB = 1024 * 1024;
+
+	void setMaxBytes(size_t bytes);
+	size_t maxBytes() const { return maxHistoryBytes; }
+	void setInterval(int frames);
+	int interval() const { return saveInterval; }
+	void reset();
+	void onFrames(EmuSystem &, int frames);
+	bool loadPrevState(EmuSystem &);
+	size_t states() const { return historyStates; }
+	explicit operator bool() const { return maxHistoryBytes; }
+
+	static size_t encodeDelta(std::span<const uint8_t> prevState, std::span<const uint8_t> state, uint8_t *output);
+	static void applyDelta(std::span<uint8_t> state, std::span<const uint8_t> delta);
+	static size_t maxEncodedDeltaSize(size_t stateSize);
+
+protected:
+	IG::RingBuffer history;
+	IG::ByteBuffer currentState;
+	IG::ByteBuffer nextState;
+	IG::ByteBuffer deltaBuff;
+	size_t maxHistoryBytes{};
+	size_t currentStateSize{};
+	size_t historyStates{};
+	int saveInterval{1};
+	int framesUntilSave{};
+
+	bool initBuffers(EmuSystem &);
+	void saveState(EmuSystem &);
+	void dropOldestState();
+	void popNewestState();
+};
+
+}
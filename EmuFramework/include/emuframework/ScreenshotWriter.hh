@@ -0,0 +1,71 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/data-type/image/PixmapWriter.hh>
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Encodes screenshots in the background so the emulation thread only pays for copying the frame.
+// Frames are copied into a small pool of reusable buffers, a worker thread encodes them in order,
+// and the result is reported on the main thread.
+
+class ScreenshotWriter
+{
+public:
+	ScreenshotWriter(ApplicationContext ctx, const Data::PixmapWriter &writer): ctx{ctx}, writer{writer} {}
+	~ScreenshotWriter();
+	// Copies the frame and queues it to be written to path, waiting if all buffers are in use
+	void write(PixmapView, CStringView path, Data::PixmapWriteParams);
+	// Blocks until all queued screenshots are written
+	void wait();
+
+protected:
+	struct Job
+	{
+		MemPixmap pix;
+		FS::PathString path;
+		Data::PixmapWriteParams params;
+	};
+
+	static constexpr size_t maxBuffers = 2;
+
+	ApplicationContext ctx;
+	const Data::PixmapWriter &writer;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<Job> jobs;
+	std::vector<MemPixmap> freeBuffers;
+	size_t usedBuffers{};
+	bool quit{};
+
+	void run();
+	MemPixmap takeBuffer(PixmapDesc, std::unique_lock<std::mutex> &);
+};
+
+}
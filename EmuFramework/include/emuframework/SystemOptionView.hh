@@ -39,12 +39,25 @@ protected:
 	BoolMenuItem confirmOverwriteState;
 	TextMenuItem fastSlowModeSpeedItem[8];
 	MultiChoiceMenuItem fastSlowModeSpeed;
+	TextMenuItem rewindBufferSizeItem[5];
+	MultiChoiceMenuItem rewindBufferSize;
+	TextMenuItem rewindIntervalItem[4];
+	MultiChoiceMenuItem rewindInterval;
+	TextMenuItem runAheadFramesItem[5];
+	MultiChoiceMenuItem runAheadFrames;
+	BoolMenuItem cacheExtractedContent;
+	TextMenuItem screenshotFormatItem[4];
+	MultiChoiceMenuItem screenshotFormat;
 	IG_UseMemberIf(Config::envIsAndroid, BoolMenuItem, performanceMode);
 	StaticArrayList<MenuItem*, 24> item;
 
 	TextMenuItem::SelectDelegate setAutosaveTimerDel();
 	TextMenuItem::SelectDelegate setAutosaveLaunchDel();
 	TextMenuItem::SelectDelegate setFastSlowModeSpeedDel();
+	TextMenuItem::SelectDelegate setRewindBufferSizeDel();
+	TextMenuItem::SelectDelegate setRewindIntervalDel();
+	TextMenuItem::SelectDelegate setRunAheadFramesDel();
+	TextMenuItem::SelectDelegate setScreenshotFormatDel();
 };
 
 }
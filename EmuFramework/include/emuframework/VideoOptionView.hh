@@ -46,6 +46,7 @@ protected:
 	IG_UseMemberIf(Config::SCREEN_FRAME_INTERVAL, TextMenuItem, frameIntervalItem[4]);
 	IG_UseMemberIf(Config::SCREEN_FRAME_INTERVAL, MultiChoiceMenuItem, frameInterval);
 	BoolMenuItem dropLateFrames;
+	BoolMenuItem lowLatencyFramePacing;
 	TextMenuItem frameRate;
 	TextMenuItem frameRatePAL;
 	StaticArrayList<TextMenuItem, MAX_ASPECT_RATIO_ITEMS> aspectRatioItem;
@@ -71,10 +72,13 @@ protected:
 	IG_UseMemberIf(Config::BASE_MULTI_SCREEN && Config::BASE_MULTI_WINDOW, BoolMenuItem, showOnSecondScreen);
 	TextMenuItem imageBuffersItem[3];
 	MultiChoiceMenuItem imageBuffers;
+	BoolMenuItem skipUnchangedRows;
 	TextMenuItem renderPixelFormatItem[3];
 	MultiChoiceMenuItem renderPixelFormat;
 	IG_UseMemberIf(Config::envIsAndroid, BoolMenuItem, presentationTime);
 	IG_UseMemberIf(Config::envIsAndroid, BoolMenuItem, forceMaxScreenFrameRate);
+	BoolMenuItem showFrameTimeStats;
+	TextMenuItem exportFrameTimeTrace;
 	TextMenuItem brightnessItem[2];
 	TextMenuItem redItem[2];
 	TextMenuItem greenItem[2];
@@ -88,7 +92,7 @@ protected:
 	TextHeadingMenuItem colorLevelsHeading;
 	TextHeadingMenuItem advancedHeading;
 	TextHeadingMenuItem systemSpecificHeading;
-	StaticArrayList<MenuItem*, 33> item;
+	StaticArrayList<MenuItem*, 37> item;
 
 	void pushAndShowFrameRateSelectMenu(VideoSystem, const Input::Event &);
 	bool onFrameTimeChange(VideoSystem vidSys, IG::FloatSeconds time);
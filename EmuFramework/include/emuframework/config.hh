@@ -30,6 +30,11 @@
 #define CONFIG_INPUT_ICADE
 #endif
 
+// batch runs fork worker processes re-executed from /proc/self/exe
+#if defined __linux__ && !defined __ANDROID__
+#define CONFIG_EMUFRAMEWORK_BATCH_RUNNER
+#endif
+
 
 namespace EmuEx
 {
@@ -0,0 +1,178 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "AutosaveWriter"
+#include <emuframework/AutosaveWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/util/string/uri.hh>
+#include <imagine/util/format.hh>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+// File format: [8-byte magic][32-bit uncompressed state size][zlib stream]
+
+constexpr char fileMagic[8]{'E', 'm', 'u', 'E', 'x', 'S', 't', '1'};
+constexpr size_t headerSize = sizeof(fileMagic) + sizeof(uint32_t);
+
+AutosaveWriter::~AutosaveWriter()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+	}
+	cond.notify_all();
+	thread.join();
+}
+
+std::span<uint8_t> AutosaveWriter::stateBuffer(size_t size)
+{
+	std::unique_lock lock{mutex};
+	cond.wait(lock, [&]{ return !hasWrite && !isCompressing; });
+	if(state.size() < size)
+		state = ByteBuffer{size};
+	return state.span().first(size);
+}
+
+void AutosaveWriter::write(CStringView path_, size_t size_)
+{
+	{
+		std::scoped_lock lock{mutex};
+		assert(!isCompressing && size_ <= state.size());
+		path = path_;
+		size = size_;
+		hasWrite = true;
+		if(!thread.joinable())
+			thread = std::thread{[this]{ run(); }};
+	}
+	cond.notify_all();
+}
+
+void AutosaveWriter::wait()
+{
+	std::unique_lock lock{mutex};
+	if(!hasWrite && !isWriting)
+		return;
+	logMsg("waiting for pending autosave write");
+	cond.wait(lock, [&]{ return !hasWrite && !isWriting; });
+}
+
+void AutosaveWriter::run()
+{
+	std::unique_lock lock{mutex};
+	while(true)
+	{
+		cond.wait(lock, [&]{ return hasWrite || quit; });
+		if(!hasWrite)
+			return;
+		hasWrite = false;
+		isCompressing = isWriting = true;
+		auto destPath = path;
+		lock.unlock();
+		auto outputSize = compress();
+		lock.lock();
+		// the state buffer can be reused as soon as it's compressed
+		isCompressing = false;
+		cond.notify_all();
+		lock.unlock();
+		bool success = outputSize && writeFile(destPath, output.span().first(outputSize));
+		lock.lock();
+		isWriting = false;
+		cond.notify_all();
+		if(!success)
+		{
+			ctx.runOnMainThread([](ApplicationContext ctx)
+			{
+				EmuApp::get(ctx).postErrorMessage(4, "Can't write autosave state");
+			});
+		}
+	}
+}
+
+size_t AutosaveWriter::compress()
+{
+	auto maxOutputSize = headerSize + compressBound(size);
+	if(output.size() < maxOutputSize)
+		output = ByteBuffer{maxOutputSize};
+	auto data = output.data();
+	uint32_t stateSize = size;
+	memcpy(data, fileMagic, sizeof(fileMagic));
+	memcpy(data + sizeof(fileMagic), &stateSize, sizeof(stateSize));
+	uLongf compressedSize = maxOutputSize - headerSize;
+	if(auto err = compress2(data + headerSize, &compressedSize, state.data(), size, Z_BEST_SPEED);
+		err != Z_OK)
+	{
+		logErr("error:%d compressing state", err);
+		return 0;
+	}
+	logMsg("compressed %zu byte state to %zu bytes", size, (size_t)compressedSize);
+	return headerSize + compressedSize;
+}
+
+bool AutosaveWriter::writeFile(CStringView path, std::span<const uint8_t> data) const
+{
+	if(isUri(path))
+	{
+		// document URIs can't be atomically replaced, write in place
+		return FileUtils::writeToUri(ctx, path, data) == ssize_t(data.size());
+	}
+	auto tempPath = FS::PathString{path}.append(".tmp");
+	if(FileUtils::writeToPath(tempPath, data) != ssize_t(data.size()))
+	{
+		logErr("error writing temporary state file:%s", tempPath.data());
+		FS::remove(tempPath);
+		return false;
+	}
+	if(!FS::rename(tempPath, path))
+	{
+		logErr("error renaming %s -> %s", tempPath.data(), path.data());
+		FS::remove(tempPath);
+		return false;
+	}
+	logMsg("wrote autosave state:%s", path.data());
+	return true;
+}
+
+bool AutosaveWriter::isStateFile(std::span<const uint8_t> data)
+{
+	return data.size() >= headerSize && std::equal(std::begin(fileMagic), std::end(fileMagic), data.begin());
+}
+
+ByteBuffer AutosaveWriter::decompressState(std::span<const uint8_t> data)
+{
+	if(!isStateFile(data))
+		throw std::runtime_error{"Invalid state file"};
+	uint32_t stateSize;
+	memcpy(&stateSize, data.data() + sizeof(fileMagic), sizeof(stateSize));
+	ByteBuffer state{stateSize};
+	uLongf destSize = stateSize;
+	if(auto err = uncompress(state.data(), &destSize, data.data() + headerSize, data.size() - headerSize);
+		err != Z_OK || destSize != stateSize)
+	{
+		throw std::runtime_error{fmt::format("Error decompressing state file ({})", err)};
+	}
+	return state;
+}
+
+}
@@ -0,0 +1,237 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Batch"
+#include <emuframework/BatchRunner.hh>
+#include <emuframework/Benchmark.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/string.h>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+#include <thread>
+#include <string>
+#include <vector>
+
+namespace EmuEx
+{
+
+struct BatchJob
+{
+	std::string contentPath;
+	size_t index{};
+	pid_t pid{};
+	SteadyClockTime startTime{};
+	Time wallTime{};
+	int exitStatus{-1};
+};
+
+static int parseCount(std::string_view str, int defaultVal)
+{
+	int val{};
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+	if(ec != std::errc{} || val < 1)
+	{
+		logWarn("invalid count:%s", std::string{str}.c_str());
+		return defaultVal;
+	}
+	return val;
+}
+
+std::optional<BatchParams> BatchParams::parse(CommandArgs args)
+{
+	std::optional<BatchParams> params;
+	auto getParams = [&]() -> BatchParams& { return params ? *params : params.emplace(); };
+	std::string_view inputScriptPath;
+	for(auto i : iotaCount(args.c))
+	{
+		std::string_view arg{args.v[i]};
+		if(arg.starts_with("--batch="))
+		{
+			getParams().listPath = arg.substr(8);
+		}
+		else if(arg.starts_with("--batch-jobs="))
+		{
+			auto &p = getParams();
+			p.jobs = parseCount(arg.substr(13), p.jobs);
+		}
+		else if(arg.starts_with("--batch-frames="))
+		{
+			auto &p = getParams();
+			p.frames = parseCount(arg.substr(15), p.frames);
+		}
+		else if(arg.starts_with("--batch-output="))
+		{
+			getParams().outputDir = arg.substr(15);
+		}
+		else if(arg.starts_with("--input-script="))
+		{
+			inputScriptPath = arg.substr(15);
+		}
+	}
+	if(!params)
+		return {};
+	if(params->listPath.empty())
+	{
+		logErr("batch options given without --batch list");
+		return {};
+	}
+	params->inputScriptPath = inputScriptPath;
+	return params;
+}
+
+static std::vector<BatchJob> readJobList(CStringView listPath)
+{
+	auto buff = FileUtils::bufferFromPath(listPath);
+	std::string_view list{(const char*)buff.data(), buff.size()};
+	std::vector<BatchJob> jobs;
+	for(auto line : std::views::split(list, '\n'))
+	{
+		std::string_view path{line.begin(), line.end()};
+		if(path.ends_with('\r'))
+			path.remove_suffix(1);
+		if(path.empty() || path.starts_with('#'))
+			continue;
+		jobs.emplace_back(std::string{path}, jobs.size());
+	}
+	return jobs;
+}
+
+static pid_t spawnWorker(const char *exePath, const BatchParams &params, const BatchJob &job)
+{
+	std::vector<std::string> args
+	{
+		exePath,
+		fmt::format("--benchmark={}", params.frames),
+		"--benchmark-warmup=0",
+		"--benchmark-hash",
+		fmt::format("--benchmark-output={}/{}.json", params.outputDir, job.index),
+		fmt::format("--hash-log={}/{}.hashes", params.outputDir, job.index),
+	};
+	if(params.inputScriptPath.size())
+		args.emplace_back(fmt::format("--input-script={}", params.inputScriptPath));
+	args.emplace_back(job.contentPath);
+	std::vector<char*> argv;
+	for(auto &a : args)
+	{
+		argv.emplace_back(a.data());
+	}
+	argv.emplace_back(nullptr);
+	auto pid = fork();
+	if(pid == 0)
+	{
+		// each worker is a separate process since the emulator cores rely on global state
+		execv(exePath, argv.data());
+		_exit(127);
+	}
+	return pid;
+}
+
+static std::string batchSummaryJson(const BatchParams &params, std::span<const BatchJob> jobs)
+{
+	std::string json;
+	auto out = std::back_inserter(json);
+	fmt::format_to(out, "{{\n\t\"jobs\": {},\n\t\"frames\": {},\n\t\"results\": [", params.jobs, params.frames);
+	for(bool first = true; auto &job : jobs)
+	{
+		fmt::format_to(out, "{}\n\t\t{{\"content\": \"{}\", \"output\": \"{}.json\", \"hashLog\": \"{}.hashes\", \"exitStatus\": {}, \"wallMs\": {:.2f}}}",
+			first ? "" : ",", jsonEscaped(job.contentPath), job.index, job.index, job.exitStatus,
+			std::chrono::duration<double, std::milli>{job.wallTime}.count());
+		first = false;
+	}
+	fmt::format_to(out, "\n\t]\n}}\n");
+	return json;
+}
+
+int runBatch(const BatchParams &paramsIn)
+{
+	auto params = paramsIn;
+	if(!params.jobs)
+		params.jobs = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<BatchJob> jobs;
+	try
+	{
+		jobs = readJobList(params.listPath);
+	}
+	catch(std::exception &err)
+	{
+		fmt::print(stderr, "error reading batch list {}:{}\n", params.listPath, err.what());
+		return 1;
+	}
+	try
+	{
+		FS::create_directory(params.outputDir);
+	}
+	catch(std::exception &err)
+	{
+		fmt::print(stderr, "error creating batch output directory {}:{}\n", params.outputDir, err.what());
+		return 1;
+	}
+	const char *exePath = "/proc/self/exe";
+	logMsg("running %zu jobs with %d processes", jobs.size(), params.jobs);
+	size_t nextJob{}, runningJobs{}, doneJobs{};
+	int failedJobs{};
+	while(doneJobs < jobs.size())
+	{
+		while(nextJob < jobs.size() && runningJobs < (size_t)params.jobs)
+		{
+			auto &job = jobs[nextJob++];
+			job.startTime = steadyClockTimestamp();
+			job.pid = spawnWorker(exePath, params, job);
+			if(job.pid == -1)
+			{
+				fmt::print(stderr, "error creating process for {}\n", job.contentPath);
+				doneJobs++;
+				failedJobs++;
+				continue;
+			}
+			runningJobs++;
+		}
+		int status{};
+		auto pid = waitpid(-1, &status, 0);
+		if(pid == -1)
+			break;
+		auto it = std::ranges::find(jobs, pid, &BatchJob::pid);
+		if(it == jobs.end())
+			continue;
+		auto &job = *it;
+		job.wallTime = steadyClockTimestamp() - job.startTime;
+		job.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+		job.pid = 0;
+		runningJobs--;
+		doneJobs++;
+		if(job.exitStatus)
+			failedJobs++;
+		fmt::print("[{}/{}] {} {}\n", doneJobs, jobs.size(), job.exitStatus ? "FAIL" : "OK", job.contentPath);
+	}
+	auto json = batchSummaryJson(params, jobs);
+	auto summaryPath = FS::pathString(params.outputDir, "summary.json");
+	if(FileUtils::writeToPath(summaryPath, std::span{(const unsigned char*)json.data(), json.size()}) == -1)
+	{
+		fmt::print(stderr, "error writing batch summary to:{}\n", summaryPath);
+		return 1;
+	}
+	fmt::print("{} of {} jobs failed\n", failedJobs, jobs.size());
+	return failedJobs ? 1 : 0;
+}
+
+}
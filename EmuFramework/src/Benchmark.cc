@@ -0,0 +1,351 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Benchmark"
+#include <emuframework/Benchmark.hh>
+#include <emuframework/EmuSystem.hh>
+#include <emuframework/EmuSystemTaskContext.hh>
+#include <emuframework/EmuVideo.hh>
+#include <emuframework/EmuAudio.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/string.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+#include <cstdio>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+static int parseFrames(std::string_view str, int defaultVal)
+{
+	int val{};
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+	if(ec != std::errc{} || val < 0)
+	{
+		logWarn("invalid frame count:%s", std::string{str}.c_str());
+		return defaultVal;
+	}
+	return val;
+}
+
+std::optional<BenchmarkParams> BenchmarkParams::parse(CommandArgs args)
+{
+	std::optional<BenchmarkParams> params;
+	auto getParams = [&]() -> BenchmarkParams& { return params ? *params : params.emplace(); };
+	std::string_view inputScriptPath;
+	std::optional<int> frames, warmupFrames;
+	for(auto i : iotaCount(args.c))
+	{
+		std::string_view arg{args.v[i]};
+		if(arg == "--benchmark")
+		{
+			getParams();
+		}
+		else if(arg.starts_with("--benchmark="))
+		{
+			getParams();
+			frames = std::max(parseFrames(arg.substr(12), frames.value_or(BenchmarkParams{}.frames)), 1);
+		}
+		else if(arg.starts_with("--benchmark-warmup="))
+		{
+			getParams();
+			warmupFrames = parseFrames(arg.substr(19), warmupFrames.value_or(BenchmarkParams{}.warmupFrames));
+		}
+		else if(arg.starts_with("--benchmark-output="))
+		{
+			getParams().outputPath = arg.substr(19);
+		}
+		else if(arg == "--benchmark-hash")
+		{
+			getParams().hashFrames = true;
+		}
+		else if(arg.starts_with("--hash-log="))
+		{
+			auto &p = getParams();
+			p.hashLogPath = arg.substr(11);
+			p.hashFrames = true;
+		}
+		else if(arg.starts_with("--input-script="))
+		{
+			inputScriptPath = arg.substr(15);
+		}
+		else if(arg.starts_with("--input-replay="))
+		{
+			getParams().inputReplayPath = arg.substr(15);
+		}
+	}
+	if(params)
+	{
+		params->inputScriptPath = inputScriptPath;
+		// a replay's frame count is filled in from the recording once it's loaded
+		bool isReplay = params->inputReplayPath.size();
+		if(frames)
+			params->frames = *frames;
+		else if(isReplay)
+			params->frames = 0;
+		if(warmupFrames)
+			params->warmupFrames = *warmupFrames;
+		else if(isReplay)
+			params->warmupFrames = 0;
+	}
+	return params;
+}
+
+FrameTimeStats FrameTimeStats::make(std::span<const Time> frameTimes)
+{
+	if(frameTimes.empty())
+		return {};
+	std::vector<Time> sorted{frameTimes.begin(), frameTimes.end()};
+	std::ranges::sort(sorted);
+	FrameTimeStats stats;
+	for(auto t : sorted)
+	{
+		stats.total += t;
+	}
+	auto size = sorted.size();
+	stats.mean = stats.total / size;
+	stats.median = size % 2 ? sorted[size / 2] : (sorted[size / 2 - 1] + sorted[size / 2]) / 2;
+	// nearest-rank percentile
+	stats.p99 = sorted[std::min(size - 1, (size * 99 + 99) / 100 - 1)];
+	stats.min = sorted.front();
+	stats.max = sorted.back();
+	return stats;
+}
+
+std::vector<InputScriptEvent> parseInputScript(std::string_view script)
+{
+	std::vector<InputScriptEvent> events;
+	int lineNum{};
+	for(auto line : std::views::split(script, '\n'))
+	{
+		lineNum++;
+		std::string_view lineStr{line.begin(), line.end()};
+		if(auto commentPos = lineStr.find('#'); commentPos != std::string_view::npos)
+			lineStr = lineStr.substr(0, commentPos);
+		InputScriptEvent e;
+		int pressed{};
+		std::string lineCopy{lineStr};
+		char extra{};
+		auto fields = sscanf(lineCopy.c_str(), "%d %u %d %c", &e.frame, &e.key, &pressed, &extra);
+		if(fields == EOF)
+			continue;
+		if(fields != 3 || e.frame < 0)
+			throw std::runtime_error{fmt::format("invalid input script line {}", lineNum)};
+		e.pressed = pressed;
+		events.emplace_back(e);
+	}
+	std::ranges::stable_sort(events, {}, &InputScriptEvent::frame);
+	return events;
+}
+
+class BenchmarkRunner
+{
+public:
+	BenchmarkRunner(EmuSystem &sys, EmuVideo &video, std::span<const InputScriptEvent> inputScript):
+		sys{sys}, video{video}, inputScript{inputScript} {}
+
+	void runFrames(bool useVideo, EmuAudio *audio, std::span<Time> frameTimes, BenchmarkPass *hashPass = {})
+	{
+		for(auto &t : frameTimes)
+		{
+			applyInput();
+			auto before = steadyClockTimestamp();
+			sys.runFrame({}, useVideo ? &video : nullptr, audio);
+			t = steadyClockTimestamp() - before;
+			if(hashPass)
+			{
+				hashPass->frameHashes.emplace_back(video.frameHash());
+				hashPass->audioHashes.emplace_back(audio ? audio->takeFrameHash() : 0);
+			}
+			frame++;
+		}
+	}
+
+	void restart(std::span<const uint8_t> state)
+	{
+		// release keys still held from the last pass since they may not be part of the state
+		for(auto &e : pressedKeys)
+		{
+			sys.handleInputAction(nullptr, {e.key, Input::Action::RELEASED, e.metaState});
+		}
+		pressedKeys.clear();
+		sys.readState(state);
+		nextEvent = 0;
+		frame = 0;
+	}
+
+protected:
+	EmuSystem &sys;
+	EmuVideo &video;
+	std::span<const InputScriptEvent> inputScript;
+	std::vector<InputScriptEvent> pressedKeys;
+	size_t nextEvent{};
+	int frame{};
+
+	void applyInput()
+	{
+		for(; nextEvent < inputScript.size() && inputScript[nextEvent].frame <= frame; nextEvent++)
+		{
+			auto &e = inputScript[nextEvent];
+			sys.handleInputAction(nullptr, {e.key, e.pressed ? Input::Action::PUSHED : Input::Action::RELEASED, e.metaState});
+			std::erase_if(pressedKeys, [&](auto &k){ return k.key == e.key; });
+			if(e.pressed)
+				pressedKeys.emplace_back(e);
+		}
+	}
+};
+
+std::vector<BenchmarkPass> runBenchmark(EmuSystem &sys, EmuVideo &video, EmuAudio *audio, const BenchmarkParams &params,
+	std::span<const InputScriptEvent> inputScript, std::span<const uint8_t> startState)
+{
+	std::vector<BenchmarkPass> passes;
+	passes.reserve(4);
+	if(params.hashFrames)
+	{
+		// hashes need the video output and a single deterministic run
+		if(audio)
+			passes.emplace_back("video+audio", true, true);
+		else
+			passes.emplace_back("video", true, false);
+	}
+	else
+	{
+		passes.emplace_back("video+audio", true, true);
+		passes.emplace_back("video", true, false);
+		passes.emplace_back("audio", false, true);
+		passes.emplace_back("none", false, false);
+	}
+	if(!audio)
+	{
+		logWarn("audio isn't active, skipping passes with audio");
+		std::erase_if(passes, [](auto &p){ return p.audio; });
+	}
+	BenchmarkRunner runner{sys, video, inputScript};
+	video.setHashFrames(params.hashFrames);
+	if(audio)
+		audio->setHashFrames(params.hashFrames);
+	if(startState.size())
+		runner.restart(startState);
+	{
+		logMsg("running %d warm-up frames", params.warmupFrames);
+		std::vector<Time> warmupTimes(params.warmupFrames);
+		runner.runFrames(true, audio, warmupTimes);
+		if(audio)
+			audio->takeFrameHash();
+	}
+	for(auto &pass : passes)
+	{
+		if(startState.size())
+			runner.restart(startState);
+		logMsg("running %d frames with sinks:%s", params.frames, pass.name.data());
+		pass.frameTimes.resize(params.frames);
+		runner.runFrames(pass.video, pass.audio ? audio : nullptr, pass.frameTimes,
+			params.hashFrames ? &pass : nullptr);
+		pass.stats = FrameTimeStats::make(pass.frameTimes);
+	}
+	video.setHashFrames(false);
+	if(audio)
+		audio->setHashFrames(false);
+	return passes;
+}
+
+static double toMs(Time t)
+{
+	return std::chrono::duration<double, std::milli>{t}.count();
+}
+
+std::string jsonEscaped(std::string_view str)
+{
+	std::string escaped;
+	escaped.reserve(str.size());
+	for(char c : str)
+	{
+		switch(c)
+		{
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if((unsigned char)c < 0x20)
+					escaped += fmt::format("\\u{:04x}", c);
+				else
+					escaped += c;
+		}
+	}
+	return escaped;
+}
+
+std::string benchmarkResultsJson(const EmuSystem &sys, const BenchmarkParams &params, std::span<const BenchmarkPass> passes)
+{
+	std::string json;
+	auto out = std::back_inserter(json);
+	fmt::format_to(out, "{{\n\t\"system\": \"{}\",\n\t\"content\": \"{}\",\n\t\"warmupFrames\": {},\n\t\"frames\": {},\n\t\"passes\": [",
+		jsonEscaped(sys.shortSystemName()), jsonEscaped(sys.contentName()), params.warmupFrames, params.frames);
+	for(bool firstPass = true; auto &pass : passes)
+	{
+		auto &s = pass.stats;
+		fmt::format_to(out, "{}\n\t\t{{\n\t\t\t\"sinks\": \"{}\",\n\t\t\t\"video\": {},\n\t\t\t\"audio\": {},\n"
+			"\t\t\t\"totalMs\": {:.4f},\n\t\t\t\"fps\": {:.2f},\n\t\t\t\"meanMs\": {:.4f},\n\t\t\t\"medianMs\": {:.4f},\n"
+			"\t\t\t\"p99Ms\": {:.4f},\n\t\t\t\"minMs\": {:.4f},\n\t\t\t\"maxMs\": {:.4f},\n\t\t\t\"frameTimesMs\": [",
+			firstPass ? "" : ",", pass.name, pass.video, pass.audio,
+			toMs(s.total), s.total.count() ? pass.frameTimes.size() / FloatSeconds{s.total}.count() : 0.,
+			toMs(s.mean), toMs(s.median), toMs(s.p99), toMs(s.min), toMs(s.max));
+		for(bool firstTime = true; auto t : pass.frameTimes)
+		{
+			fmt::format_to(out, "{}{:.4f}", firstTime ? "" : ", ", toMs(t));
+			firstTime = false;
+		}
+		fmt::format_to(out, "]");
+		if(pass.frameHashes.size())
+		{
+			fmt::format_to(out, ",\n\t\t\t\"frameHashes\": [");
+			for(bool firstHash = true; auto h : pass.frameHashes)
+			{
+				fmt::format_to(out, "{}\"{:016x}\"", firstHash ? "" : ", ", h);
+				firstHash = false;
+			}
+			fmt::format_to(out, "],\n\t\t\t\"audioHashes\": [");
+			for(bool firstHash = true; auto h : pass.audioHashes)
+			{
+				fmt::format_to(out, "{}\"{:016x}\"", firstHash ? "" : ", ", h);
+				firstHash = false;
+			}
+			fmt::format_to(out, "]");
+		}
+		fmt::format_to(out, "\n\t\t}}");
+		firstPass = false;
+	}
+	fmt::format_to(out, "\n\t]\n}}\n");
+	return json;
+}
+
+std::string frameHashLog(const EmuSystem &sys, const BenchmarkParams &params, const BenchmarkPass &pass)
+{
+	std::string log;
+	auto out = std::back_inserter(log);
+	fmt::format_to(out, "# EmuEx hash log v1\n# system:{} content:{} sinks:{}\n# frame video audio\n",
+		sys.shortSystemName(), sys.contentName(), pass.name);
+	for(auto i : iotaCount(pass.frameHashes.size()))
+	{
+		fmt::format_to(out, "{} {:016x} {:016x}\n", params.warmupFrames + i, pass.frameHashes[i], pass.audioHashes[i]);
+	}
+	return log;
+}
+
+}
@@ -285,6 +285,7 @@ void EmuApp::saveConfigFile(FileIO &io)
 		optionImgEffect,
 		optionImageEffectPixelFormat,
 		optionVideoImageBuffers,
+		optionSkipUnchangedVideoRows,
 		optionOverlayEffect,
 		optionOverlayEffectLevel,
 		optionFontSize,
@@ -293,11 +294,15 @@ void EmuApp::saveConfigFile(FileIO &io)
 		optionMenuOrientation,
 		optionConfirmOverwriteState,
 		optionFastSlowModeSpeed,
+		optionRewindBufferSize,
+		optionRewindInterval,
+		optionRunAheadFrames,
 		#ifdef CONFIG_INPUT_DEVICE_HOTSWAP
 		optionNotifyInputDeviceChange,
 		#endif
 		optionFrameInterval,
 		optionSkipLateFrames,
+		optionLowLatencyFramePacing,
 		optionFrameRate,
 		optionFrameRatePAL,
 		optionNotificationIcon,
@@ -317,6 +322,9 @@ void EmuApp::saveConfigFile(FileIO &io)
 		#endif
 		optionSoundBuffers,
 		optionAddSoundBuffersOnUnderrun,
+		optionDynamicRateControl,
+		optionCacheExtractedContent,
+		optionScreenshotFormat,
 		#ifdef CONFIG_AUDIO_MULTIPLE_SYSTEM_APIS
 		optionAudioAPI,
 		#endif
@@ -554,6 +562,7 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_FRAME_INTERVAL:
 					return doIfUsed(optionFrameInterval, [&](auto &opt){return opt.readFromIO(io, size);});
 				case CFGKEY_SKIP_LATE_FRAMES: return optionSkipLateFrames.readFromIO(io, size);
+				case CFGKEY_LOW_LATENCY_FRAME_PACING: return optionLowLatencyFramePacing.readFromIO(io, size);
 				case CFGKEY_FRAME_RATE: return optionFrameRate.readFromIO(io, size);
 				case CFGKEY_FRAME_RATE_PAL: return optionFrameRatePAL.readFromIO(io, size);
 				case CFGKEY_LAST_DIR:
@@ -574,6 +583,7 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 					setRenderPixelFormat(readOptionValue<IG::PixelFormat>(io, size, renderPixelFormatIsValid));
 					return true;
 				case CFGKEY_VIDEO_IMAGE_BUFFERS: return optionVideoImageBuffers.readFromIO(io, size);
+				case CFGKEY_SKIP_UNCHANGED_VIDEO_ROWS: return optionSkipUnchangedVideoRows.readFromIO(io, size);
 				case CFGKEY_OVERLAY_EFFECT: return optionOverlayEffect.readFromIO(io, size);
 				case CFGKEY_OVERLAY_EFFECT_LEVEL: return optionOverlayEffectLevel.readFromIO(io, size);
 				case CFGKEY_TOUCH_CONTROL_VIRBRATE:
@@ -596,6 +606,9 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 					return ctx.hasTranslucentSysUI() ? readOptionValue(io, size, layoutBehindSystemUI) : false;
 				case CFGKEY_CONFIRM_OVERWRITE_STATE: return optionConfirmOverwriteState.readFromIO(io, size);
 				case CFGKEY_FAST_SLOW_MODE_SPEED: return optionFastSlowModeSpeed.readFromIO(io, size);
+				case CFGKEY_REWIND_BUFFER_SIZE: return optionRewindBufferSize.readFromIO(io, size);
+				case CFGKEY_REWIND_INTERVAL: return optionRewindInterval.readFromIO(io, size);
+				case CFGKEY_RUN_AHEAD_FRAMES: return optionRunAheadFrames.readFromIO(io, size);
 				#ifdef CONFIG_INPUT_DEVICE_HOTSWAP
 				case CFGKEY_NOTIFY_INPUT_DEVICE_CHANGE: return optionNotifyInputDeviceChange.readFromIO(io, size);
 				#endif
@@ -617,6 +630,9 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_SOUND_BUFFERS: return optionSoundBuffers.readFromIO(io, size);
 				case CFGKEY_SOUND_VOLUME: return optionSoundVolume.readFromIO(io, size);
 				case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return optionAddSoundBuffersOnUnderrun.readFromIO(io, size);
+				case CFGKEY_DYNAMIC_RATE_CONTROL: return optionDynamicRateControl.readFromIO(io, size);
+				case CFGKEY_CACHE_EXTRACTED_CONTENT: return optionCacheExtractedContent.readFromIO(io, size);
+				case CFGKEY_SCREENSHOT_FORMAT: return optionScreenshotFormat.readFromIO(io, size);
 				case CFGKEY_AUDIO_SOLO_MIX:
 					audioManager().setSoloMix(readOptionValue<bool>(io, size));
 					return true;
@@ -21,6 +21,7 @@
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/FilePicker.hh>
+#include <emuframework/BatchRunner.hh>
 #include "AutosaveSlotView.hh"
 #include "privateInput.hh"
 #include "WindowData.hh"
@@ -43,6 +44,7 @@
 #include <imagine/util/string.h>
 #include <imagine/thread/Thread.hh>
 #include <cmath>
+#include <limits>
 
 namespace EmuEx
 {
@@ -133,8 +135,21 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 			return true;
 		}
 	},
+	framePacingTimer
+	{
+		"EmuApp::framePacingTimer",
+		[this]()
+		{
+			runPacedFrame();
+			// outside of the frame callbacks so the draw must be posted
+			viewController().emuWindow().postDraw();
+			return false;
+		}
+	},
+	autosaveWriter{ctx},
 	pixmapReader{ctx},
 	pixmapWriter{ctx},
+	screenshotWriter{ctx, pixmapWriter},
 	vibrationManager_{ctx},
 	optionAspectRatio{CFGKEY_GAME_ASPECT_RATIO, (double)EmuSystem::aspectRatioInfos()[0], 0, optionAspectRatioIsValid},
 	optionFrameRate{CFGKEY_FRAME_RATE, 0, 0, optionFrameTimeIsValid},
@@ -150,12 +165,18 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	optionAutosaveTimerMins{CFGKEY_AUTOSAVE_TIMER_MINS, 5},
 	optionConfirmOverwriteState{CFGKEY_CONFIRM_OVERWRITE_STATE, 1},
 	optionFastSlowModeSpeed{CFGKEY_FAST_SLOW_MODE_SPEED, 800, false, optionIsValidWithMinMax<int(MIN_RUN_SPEED * 100.), int(MAX_RUN_SPEED * 100.)>},
+	optionRewindBufferSize{CFGKEY_REWIND_BUFFER_SIZE, 0, false, optionIsValidWithMax<128>},
+	optionRewindInterval{CFGKEY_REWIND_INTERVAL, 1, false, optionIsValidWithMinMax<1, 60>},
+	optionRunAheadFrames{CFGKEY_RUN_AHEAD_FRAMES, 0, false, optionIsValidWithMax<4>},
 	optionSound{CFGKEY_SOUND, OPTION_SOUND_DEFAULT_FLAGS},
 	optionSoundVolume{CFGKEY_SOUND_VOLUME,
 		100, false, optionIsValidWithMinMax<0, 100, uint8_t>},
 	optionSoundBuffers{CFGKEY_SOUND_BUFFERS,
 		3, 0, optionIsValidWithMinMax<1, 7, uint8_t>},
 	optionAddSoundBuffersOnUnderrun{CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, 1, 0},
+	optionDynamicRateControl{CFGKEY_DYNAMIC_RATE_CONTROL, 1, 0},
+	optionCacheExtractedContent{CFGKEY_CACHE_EXTRACTED_CONTENT, 0},
+	optionScreenshotFormat{CFGKEY_SCREENSHOT_FORMAT, 0, false, optionIsValidWithMax<3>},
 	optionAudioAPI{CFGKEY_AUDIO_API, 0},
 	optionNotificationIcon{CFGKEY_NOTIFICATION_ICON, 1, !Config::envIsAndroid},
 	optionTitleBar{CFGKEY_TITLE_BAR, 1, !CAN_HIDE_TITLE_BAR},
@@ -178,11 +199,13 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	optionOverlayEffectLevel{CFGKEY_OVERLAY_EFFECT_LEVEL, 75, 0, optionIsValidWithMax<100>},
 	optionFrameInterval{CFGKEY_FRAME_INTERVAL,	1, !Config::envIsIOS, optionIsValidWithMinMax<1, 4, uint8_t>},
 	optionSkipLateFrames{CFGKEY_SKIP_LATE_FRAMES, 1, 0},
+	optionLowLatencyFramePacing{CFGKEY_LOW_LATENCY_FRAME_PACING, 0, 0},
 	optionImageZoom(CFGKEY_IMAGE_ZOOM, 100, 0, optionImageZoomIsValid),
 	optionViewportZoom(CFGKEY_VIEWPORT_ZOOM, 100, 0, optionIsValidWithMinMax<50, 100>),
 	optionShowOnSecondScreen{CFGKEY_SHOW_ON_2ND_SCREEN, 0},
 	optionTextureBufferMode{CFGKEY_TEXTURE_BUFFER_MODE, 0},
 	optionVideoImageBuffers{CFGKEY_VIDEO_IMAGE_BUFFERS, 0, 0, optionIsValidWithMax<2>},
+	optionSkipUnchangedVideoRows{CFGKEY_SKIP_UNCHANGED_VIDEO_ROWS, 0},
 	layoutBehindSystemUI{ctx.hasTranslucentSysUI()}
 {
 	if(ctx.registerInstance(initParams))
@@ -285,12 +308,18 @@ static void suspendEmulation(EmuApp &app)
 		return;
 	app.saveAutosave();
 	app.system().flushBackupMemory(app);
+	// the app may be killed while suspended
+	app.waitForPendingWrites();
 }
 
 void EmuApp::closeSystem()
 {
 	showUI();
 	emuSystemTask.stop();
+	cancelInputRecording("content closed");
+	rewindManager.reset();
+	runAheadState = {};
+	runAheadUnsupported = false;
 	system().closeRuntimeSystem(*this);
 	autoSaveSlot = "";
 	viewController().onSystemClosed();
@@ -339,13 +368,16 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 
 static const char *parseCommandArgs(IG::CommandArgs arg)
 {
-	if(arg.c < 2)
+	for(int i = 1; i < arg.c; i++)
 	{
-		return nullptr;
+		// skip any option arguments
+		if(std::string_view{arg.v[i]}.starts_with("--"))
+			continue;
+		auto launchPath = arg.v[i];
+		logMsg("starting content from command line:%s", launchPath);
+		return launchPath;
 	}
-	auto launchPath = arg.v[1];
-	logMsg("starting content from command line:%s", launchPath);
-	return launchPath;
+	return nullptr;
 }
 
 bool EmuApp::setWindowDrawableConfig(Gfx::DrawableConfig conf)
@@ -483,6 +515,14 @@ static IG::Screen *extraWindowScreen(IG::ApplicationContext ctx)
 
 void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::ApplicationContext ctx)
 {
+	#ifdef CONFIG_EMUFRAMEWORK_BATCH_RUNNER
+	if(auto batchParams = BatchParams::parse(initParams.commandArgs());
+		batchParams)
+	{
+		// the batch controller only manages worker processes and never opens a window
+		std::exit(runBatch(*batchParams));
+	}
+	#endif
 	auto appConfig = loadConfigFile(ctx);
 	system().onOptionsLoaded();
 	loadSystemOptions();
@@ -490,11 +530,13 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 	if(auto launchGame = parseCommandArgs(initParams.commandArgs());
 		launchGame)
 		system().setInitialLoadPath(launchGame);
+	benchmarkParams = BenchmarkParams::parse(initParams.commandArgs());
 	audioManager().setMusicVolumeControlHint();
 	if(optionSoundRate > optionSoundRate.defaultVal)
 		optionSoundRate.reset();
 	emuAudio.setRate(optionSoundRate);
 	emuAudio.setAddSoundBuffersOnUnderrun(optionAddSoundBuffersOnUnderrun);
+	emuAudio.setDynamicRateControl(optionDynamicRateControl);
 	if(!renderer.supportsColorSpace())
 		windowDrawableConf.colorSpace = {};
 	applyOSNavStyle(ctx, false);
@@ -523,8 +565,11 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 			emuAudio.close();
 			audioManager().endSession();
 
-			saveConfigFile(ctx);
-			saveSystemOptions();
+			if(!benchmarkParams)
+			{
+				saveConfigFile(ctx);
+				saveSystemOptions();
+			}
 
 			#ifdef CONFIG_INPUT_BLUETOOTH
 			if(bta && (!backgrounded || (backgrounded && !optionKeepBluetoothActive)))
@@ -605,6 +650,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 			emuVideo.setRendererTask(renderer.task());
 			emuVideo.setTextureBufferMode(system(), (Gfx::TextureBufferMode)optionTextureBufferMode.val);
 			emuVideo.setImageBuffers(optionVideoImageBuffers);
+			emuVideo.setSkipUnchangedRows(optionSkipUnchangedVideoRows);
 			emuVideoLayer.setLinearFilter(optionImgFilter); // init the texture sampler before setting format
 			applyRenderPixelFormat();
 			emuVideoLayer.setOverlay((ImageOverlayId)optionOverlayEffect.val);
@@ -635,6 +681,11 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					{
 						return true;
 					}
+					if(frameProfiler_.isEnabled()) [[unlikely]]
+					{
+						frameProfiler_.beginFrame(frameInfo.advanced, audio ? audio.bufferFill() : 0.f);
+						viewController.updateFrameTimeStats();
+					}
 					if(!shouldSkipLateFrames() && !altSpeed)
 					{
 						frameInfo.advanced = frameInterval();
@@ -648,15 +699,10 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					auto &video = this->video();
 					if(framesToEmulate == 1)
 					{
-						// run common 1-frame case synced until the video frame is ready for more consistent timing
-						emuSystemTask.runFrame(&video, audioPtr, 1, false, true);
-						if(emuSystemTask.resetVideoFormatChanged())
-						{
-							video.dispatchFormatChanged();
-						}
-						viewController.emuWindow().setNeedsDraw(true);
-						if(usePresentationTime())
-							renderer.setPresentationTime(viewController.emuWindow(), params.presentTime());
+						if(optionLowLatencyFramePacing && !altSpeed)
+							schedulePacedFrame(params);
+						else
+							runSyncedFrame(params.presentTime());
 						return true;
 					}
 					else
@@ -802,6 +848,13 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 				launchPathStr.size())
 			{
 				system().setInitialLoadPath("");
+				if(benchmarkParams)
+				{
+					// video passes need the renderer, so this runs once the window exists,
+					// but it's never shown since the app exits when done
+					runBenchmarkFromCommandLine(launchPathStr);
+					return;
+				}
 				handleOpenFileCommand(launchPathStr);
 			}
 
@@ -925,6 +978,86 @@ void EmuApp::runBenchmarkOneShot(EmuVideo &emuVideo)
 	postMessage(2, 0, fmt::format("{:.2f} fps", double(180.)/time.count()));
 }
 
+void EmuApp::runBenchmarkFromCommandLine(IG::CStringView path)
+{
+	auto ctx = appContext();
+	// params stay set so the config isn't saved on exit, allowing parallel runs
+	auto &params = *benchmarkParams;
+	std::vector<InputScriptEvent> inputScript;
+	InputRecording replay;
+	try
+	{
+		if(params.inputReplayPath.size())
+		{
+			auto buff = FileUtils::bufferFromUri(ctx, params.inputReplayPath, {}, std::numeric_limits<size_t>::max());
+			replay = InputRecording::read(buff.span());
+			inputScript = std::move(replay.events);
+			if(!params.frames)
+				params.frames = std::max(replay.frames, 1);
+		}
+		else if(params.inputScriptPath.size())
+		{
+			auto buff = FileUtils::bufferFromUri(ctx, params.inputScriptPath);
+			inputScript = parseInputScript({(const char*)buff.data(), buff.size()});
+		}
+		// load on the main thread since no UI is shown during the benchmark
+		system().createWithMedia({}, path, ctx.fileUriDisplayName(path), {},
+			[](int, int, const char *){ return true; });
+	}
+	catch(std::exception &err)
+	{
+		logErr("error loading benchmark content:%s", err.what());
+		fmt::print(stderr, "error loading content:{}\n", err.what());
+		ctx.exit(1);
+		return;
+	}
+	onSystemCreated();
+	if(soundIsEnabled())
+		startAudio();
+	logMsg("starting benchmark");
+	std::vector<BenchmarkPass> passes;
+	try
+	{
+		passes = runBenchmark(system(), video(), audio() ? &audio() : nullptr, params, inputScript, replay.state.span());
+	}
+	catch(std::exception &err)
+	{
+		logErr("error running benchmark:%s", err.what());
+		fmt::print(stderr, "error running benchmark:{}\n", err.what());
+		closeSystemWithoutSave();
+		ctx.exit(1);
+		return;
+	}
+	audio().stop();
+	auto json = benchmarkResultsJson(system(), params, passes);
+	std::string hashLog;
+	if(params.hashLogPath.size() && passes.size())
+		hashLog = frameHashLog(system(), params, passes.front());
+	closeSystemWithoutSave();
+	int exitVal = 0;
+	if(params.hashLogPath.size())
+	{
+		if(FileUtils::writeToUri(ctx, params.hashLogPath, std::span{(const unsigned char*)hashLog.data(), hashLog.size()}) == -1)
+		{
+			logErr("error writing hash log to:%s", params.hashLogPath.data());
+			exitVal = 1;
+		}
+	}
+	if(params.outputPath.size())
+	{
+		if(FileUtils::writeToUri(ctx, params.outputPath, std::span{(const unsigned char*)json.data(), json.size()}) == -1)
+		{
+			logErr("error writing benchmark results to:%s", params.outputPath.data());
+			exitVal = 1;
+		}
+	}
+	else
+	{
+		fmt::print("{}", json);
+	}
+	ctx.exit(exitVal);
+}
+
 void EmuApp::showEmulation()
 {
 	if(viewController().isShowingEmulation() || !system().hasContent())
@@ -1039,6 +1172,10 @@ void EmuApp::reloadSystem(EmuSystemCreateParams params)
 
 void EmuApp::onSystemCreated()
 {
+	rewindManager.reset();
+	applyRewindOptions();
+	runAheadState = {};
+	runAheadUnsupported = false;
 	prepareAudio();
 	updateContentRotation();
 	viewController().onSystemCreated();
@@ -1129,7 +1266,7 @@ bool EmuApp::saveAutosave()
 		return true;
 	logMsg("saving autosave slot:%s", autoSaveSlot.c_str());
 	system().flushBackupMemory(*this);
-	return saveState(currentAutosaveStatePath());
+	return saveAutosaveState(currentAutosaveStatePath());
 }
 
 bool EmuApp::loadAutosave(LoadAutosaveMode mode)
@@ -1146,12 +1283,60 @@ bool EmuApp::loadAutosave(LoadAutosaveMode mode)
 			return true;
 		}
 		logMsg("loading autosave state");
-		return loadState(statePath);
+		return loadAutosaveState(statePath);
 	}
 	else
 	{
 		logMsg("autosave state doesn't exist, creating");
-		return saveState(statePath);
+		return saveAutosaveState(statePath);
+	}
+}
+
+void EmuApp::waitForPendingWrites()
+{
+	autosaveWriter.wait();
+	screenshotWriter.wait();
+}
+
+bool EmuApp::saveAutosaveState(IG::CStringView path)
+{
+	if(!system().hasContent())
+		return false;
+	syncEmulationThread();
+	auto size = system().stateSize();
+	if(!size)
+		return saveState(path); // system only supports file states
+	logMsg("capturing autosave state %s", path.data());
+	try
+	{
+		autosaveWriter.write(path, system().writeState(autosaveWriter.stateBuffer(size)));
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(4, fmt::format("Can't save state:\n{}", err.what()));
+		return false;
+	}
+}
+
+bool EmuApp::loadAutosaveState(IG::CStringView path)
+{
+	autosaveWriter.wait();
+	syncEmulationThread();
+	try
+	{
+		auto file = FileUtils::bufferFromUri(appContext(), path);
+		if(!AutosaveWriter::isStateFile(file.span()))
+			return loadState(path); // written by EmuSystem::saveState()
+		cancelInputRecording("state loaded");
+		system().readState(AutosaveWriter::decompressState(file.span()).span());
+		resetAutosaveStateTimer();
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(4, fmt::format("Can't load state:\n{}", err.what()));
+		return false;
 	}
 }
 
@@ -1173,6 +1358,7 @@ bool EmuApp::setAutosave(std::string_view name)
 
 bool EmuApp::renameAutosave(std::string_view name, std::string_view newName)
 {
+	autosaveWriter.wait();
 	if(!appContext().renameFileUri(system().contentLocalSaveDirectory(name),
 		system().contentLocalSaveDirectory(newName)))
 	{
@@ -1187,6 +1373,7 @@ bool EmuApp::deleteAutosave(std::string_view name)
 {
 	if(name == autoSaveSlot)
 		return false;
+	autosaveWriter.wait();
 	auto ctx = appContext();
 	if(!ctx.forEachInDirectoryUri(system().contentLocalSaveDirectory(name),
 			[this, ctx](const FS::directory_entry &e)
@@ -1295,6 +1482,7 @@ bool EmuApp::loadState(IG::CStringView path)
 	}
 	logMsg("loading state %s", path.data());
 	syncEmulationThread();
+	cancelInputRecording("state loaded");
 	try
 	{
 		system().loadState(*this, path);
@@ -1368,12 +1556,20 @@ void EmuApp::runTurboInputEvents()
 {
 	assert(system().hasContent());
 	turboActions.update(*this);
+	inputRecorder_.onFrameStart();
+}
+
+void EmuApp::handleSystemInput(InputAction action)
+{
+	system().handleInputAction(this, action);
+	inputRecorder_.record(action);
 }
 
 void EmuApp::resetInput()
 {
 	removeTurboInputEvents();
 	setRunSpeed(1.);
+	setRewinding(false);
 }
 
 void EmuApp::setRunSpeed(double speed)
@@ -1562,6 +1758,13 @@ void EmuApp::configFrameTime()
 
 void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio, int frames, bool skipForward)
 {
+	if(isRewinding) [[unlikely]]
+	{
+		// step back one snapshot and run a single silent frame to present it
+		rewindManager.loadPrevState(system());
+		system().runFrame(taskCtx, video, nullptr);
+		return;
+	}
 	if(skipForward) [[unlikely]]
 	{
 		if(skipForwardFrames(taskCtx, frames - 1))
@@ -1580,8 +1783,157 @@ void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *
 		skipFrames(taskCtx, frames - 1, audio);
 	}
 	runTurboInputEvents();
-	system().runFrame(taskCtx, video, audio);
+	if(optionRunAheadFrames && !runAheadUnsupported && !skipForward) [[unlikely]]
+		runFrameAhead(taskCtx, video, audio);
+	else
+		system().runFrame(taskCtx, video, audio);
 	system().updateBackupMemoryCounter();
+	rewindManager.onFrames(system(), frames);
+}
+
+void EmuApp::runSyncedFrame(IG::FrameTime presentTime)
+{
+	// run common 1-frame case synced until the video frame is ready for more consistent timing
+	auto &video = this->video();
+	emuSystemTask.runFrame(&video, audio() ? &audio() : nullptr, 1, false, true);
+	if(emuSystemTask.resetVideoFormatChanged())
+	{
+		video.dispatchFormatChanged();
+	}
+	auto &win = viewController().emuWindow();
+	win.setNeedsDraw(true);
+	if(usePresentationTime())
+		renderer.setPresentationTime(win, presentTime);
+}
+
+void EmuApp::schedulePacedFrame(IG::FrameParams params)
+{
+	if(framePacingTimer.isArmed()) [[unlikely]]
+	{
+		// the last frame hasn't started by the next display frame, run it now
+		framePacingTimer.cancel();
+		framePacer_.addMissedStart();
+		runPacedFrame();
+	}
+	pacedFramePresentTime = params.presentTime();
+	auto delay = framePacer_.startDelay(steadyClockTimestamp(),
+		std::chrono::duration_cast<SteadyClockTime>(pacedFramePresentTime), params.frameTime());
+	if(delay < FramePacer::minDelay)
+	{
+		runPacedFrame();
+		return;
+	}
+	// keep handling input events until the frame needs to start
+	framePacingTimer.runIn(delay);
+}
+
+void EmuApp::runPacedFrame()
+{
+	auto start = steadyClockTimestamp();
+	runSyncedFrame(pacedFramePresentTime);
+	auto ready = steadyClockTimestamp();
+	framePacer_.addFrame(ready - start, ready, std::chrono::duration_cast<SteadyClockTime>(pacedFramePresentTime));
+}
+
+void EmuApp::setLowLatencyFramePacing(bool on)
+{
+	optionLowLatencyFramePacing = on;
+	framePacer_.reset();
+}
+
+void EmuApp::runFrameAhead(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
+{
+	// run the real frame with audio, save its state, then run the extra frames
+	// hidden and present the last one so input shows up that many frames sooner,
+	// finally restoring the saved state to continue from the real frame
+	auto &sys = system();
+	if(!runAheadState)
+	{
+		auto size = sys.stateSize();
+		if(!size)
+		{
+			logWarn("system doesn't support memory save states, disabling run-ahead");
+			runAheadUnsupported = true;
+			sys.runFrame(taskCtx, video, audio);
+			return;
+		}
+		runAheadState = IG::ByteBuffer{size};
+	}
+	sys.runFrame(taskCtx, nullptr, audio);
+	size_t stateSize{};
+	bool presentedFrame{};
+	try
+	{
+		stateSize = sys.writeState(runAheadState.span());
+		for(auto i : iotaCount(optionRunAheadFrames - 1))
+		{
+			sys.runFrame(taskCtx, nullptr, nullptr);
+		}
+		sys.runFrame(taskCtx, video, nullptr);
+		presentedFrame = true;
+		sys.readState({runAheadState.data(), stateSize});
+	}
+	catch(std::exception &err)
+	{
+		logErr("error in run-ahead:%s", err.what());
+		if(stateSize)
+		{
+			// go back to the real frame if any extra frames ran
+			try
+			{
+				sys.readState({runAheadState.data(), stateSize});
+			}
+			catch(std::exception &err)
+			{
+				logErr("error restoring run-ahead state:%s", err.what());
+			}
+		}
+		if(video && !presentedFrame)
+			video->startUnchangedFrame(taskCtx);
+		// state size may have changed, re-allocate the buffer on the next frame
+		runAheadState = {};
+	}
+}
+
+void EmuApp::setRewindBufferSizeMB(uint8_t mb)
+{
+	syncEmulationThread();
+	optionRewindBufferSize = mb;
+	applyRewindOptions();
+}
+
+void EmuApp::setRewindInterval(uint8_t frames)
+{
+	syncEmulationThread();
+	optionRewindInterval = frames;
+	applyRewindOptions();
+}
+
+void EmuApp::setRunAheadFrames(uint8_t frames)
+{
+	syncEmulationThread();
+	optionRunAheadFrames = frames;
+	runAheadState = {};
+}
+
+void EmuApp::applyRewindOptions()
+{
+	rewindManager.setMaxBytes(optionRewindBufferSize * RewindManager::MB);
+	rewindManager.setInterval(optionRewindInterval);
+}
+
+bool EmuApp::rewindIsEnabled() const
+{
+	return (bool)rewindManager;
+}
+
+void EmuApp::setRewinding(bool on)
+{
+	if(on && !rewindManager)
+		return;
+	if(on)
+		cancelInputRecording("rewind used");
+	isRewinding = on;
 }
 
 void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audio)
@@ -1608,19 +1960,89 @@ bool EmuApp::skipForwardFrames(EmuSystemTaskContext taskCtx, int frames)
 	return true;
 }
 
-bool EmuApp::writeScreenshot(IG::PixmapView pix, IG::CStringView path)
+void EmuApp::queueScreenshot(IG::PixmapView pix)
+{
+	auto params = screenshotWriteParams();
+	screenshotWriter.write(pix, makeNextScreenshotFilename(params.fileExtension()), params);
+}
+
+bool EmuApp::exportFrameTimeTrace()
+{
+	auto path = FS::pathString(appContext().storagePath(),
+		fmt::format("frameTrace {}.json", appContext().formatDateAndTimeAsFilename(wallClockTimestamp())));
+	if(!frameProfiler_.writeChromeTrace(path))
+	{
+		postErrorMessage("Error writing frame time trace, make sure stats are enabled while content runs");
+		return false;
+	}
+	postMessage(fmt::format("Wrote frame time trace:\n{}", path));
+	return true;
+}
+
+bool EmuApp::startInputRecording()
+{
+	if(!system().hasContent())
+		return false;
+	syncEmulationThread();
+	try
+	{
+		inputRecorder_.start(system());
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(fmt::format("Can't start input recording:\n{}", err.what()));
+		return false;
+	}
+	postMessage("Started input recording");
+	return true;
+}
+
+bool EmuApp::stopInputRecording()
 {
-	return pixmapWriter.writeToFile(pix, path);
+	if(!inputRecorder_.isRecording())
+		return false;
+	syncEmulationThread();
+	auto rec = inputRecorder_.stop();
+	auto path = system().contentSaveFilePath(
+		fmt::format(" {}.inputrec", appContext().formatDateAndTimeAsFilename(wallClockTimestamp())));
+	auto data = rec.write();
+	if(FileUtils::writeToUri(appContext(), path, {data.data(), data.size()}) == -1)
+	{
+		postErrorMessage("Error writing input recording");
+		return false;
+	}
+	postMessage(fmt::format("Wrote input recording of {} frames:\n{}", rec.frames, appContext().fileUriDisplayName(path)));
+	return true;
 }
 
-FS::PathString EmuApp::makeNextScreenshotFilename()
+void EmuApp::cancelInputRecording(std::string_view reason)
+{
+	if(!inputRecorder_.isRecording())
+		return;
+	inputRecorder_.cancel();
+	postErrorMessage(fmt::format("Input recording stopped, {}", reason));
+}
+
+IG::Data::PixmapWriteParams EmuApp::screenshotWriteParams() const
+{
+	using namespace IG::Data;
+	switch(optionScreenshotFormat.val)
+	{
+		case 1: return {.compressionLevel = 1, .filter = PngFilter::SUB}; // fast PNG
+		case 2: return {.compressionLevel = 9, .filter = PngFilter::ALL}; // small PNG
+		case 3: return {.format = PixmapFileFormat::BMP};
+	}
+	return {};
+}
+
+FS::PathString EmuApp::makeNextScreenshotFilename(std::string_view extension)
 {
 	static constexpr std::string_view subDirName = "screenshots";
 	auto &sys = system();
 	auto userPath = sys.userPath(userScreenshotDir);
 	sys.createContentLocalDirectory(userPath, subDirName);
 	return sys.contentLocalDirectory(userPath, subDirName,
-		appContext().formatDateAndTimeAsFilename(wallClockTimestamp()).append(".png"));
+		appContext().formatDateAndTimeAsFilename(wallClockTimestamp()).append(extension));
 }
 
 bool EmuApp::mogaManagerIsActive() const
@@ -1716,6 +2138,12 @@ void EmuApp::setAddSoundBuffersOnUnderrun(bool on)
 	audio().setAddSoundBuffersOnUnderrun(on);
 }
 
+void EmuApp::setDynamicRateControl(bool on)
+{
+	optionDynamicRateControl = on;
+	audio().setDynamicRateControl(on);
+}
+
 bool EmuApp::soundDuringFastSlowModeIsEnabled() const
 {
 	return optionSound & OPTION_SOUND_DURING_FAST_SLOW_MODE_ENABLED_FLAG;
@@ -1985,6 +2413,7 @@ void EmuApp::addOnFrame()
 
 void EmuApp::removeOnFrame()
 {
+	framePacingTimer.cancel();
 	viewController().emuWindow().removeOnFrame(system().onFrameUpdate, windowFrameClockSource());
 }
 
@@ -18,6 +18,7 @@
 #include <emuframework/EmuSystem.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/util/algorithm.h>
+#include <imagine/util/hash.hh>
 #include <imagine/logger/logger.h>
 
 namespace EmuEx
@@ -89,6 +90,21 @@ bool EmuAudio::shouldStartAudioWrites(size_t bytesToWrite) const
 	return rBuff.size() + bytesToWrite >= targetBufferFillBytes;
 }
 
+// max change of the resample ratio from the speed multiplier, small enough to be inaudible
+constexpr double maxRateControlDelta = .005;
+
+double EmuAudio::resampleStep() const
+{
+	if(!dynamicRateControl || audioWriteState != AudioWriteState::ACTIVE)
+		return speedMultiplier;
+	// consume input faster when the buffer is above its fill target and slower when below,
+	// so the output rate converges on the device's actual playback rate
+	auto fill = (double)rBuff.size();
+	auto target = (double)targetBufferFillBytes;
+	auto fillDelta = std::clamp((fill - target) / target, -1., 1.);
+	return speedMultiplier * (1. + fillDelta * maxRateControlDelta);
+}
+
 template<typename T>
 static void simpleResample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames)
 {
@@ -237,6 +253,7 @@ void EmuAudio::stop()
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::close()
@@ -255,16 +272,22 @@ void EmuAudio::flush()
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 {
 	assumeExpr(rBuff);
 	auto inputFormat = format();
+	if(hashFrames) [[unlikely]]
+	{
+		// hash the samples as produced by the system, before any resampling
+		frameHash = IG::hashBytes({(const unsigned char*)samples, inputFormat.framesToBytes(framesToWrite)}, frameHash);
+	}
 	switch(audioWriteState)
 	{
 		case AudioWriteState::MULTI_UNDERRUN:
-			if(speedMultiplier == 1. && addSoundBuffersOnUnderrun &&
+			if(speedMultiplier == 1. && addSoundBuffersOnUnderrun && !dynamicRateControl &&
 				inputFormat.bytesToTime(rBuff.capacity()).count() <= 1.) // hard cap buffer increase to 1 sec
 			{
 				logWarn("increasing buffer size due to multiple underruns within a short time");
@@ -279,7 +302,22 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		break;
 	}
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
+	if(dynamicRateControl)
+	{
+		auto step = resampleStep();
+		auto maxBytes = inputFormat.framesToBytes(IG::Audio::Resampler::maxDestFrames(sampleFrames, step));
+		if(maxBytes <= rBuff.freeSpace()) [[likely]]
+		{
+			auto bytes = inputFormat.framesToBytes(resampler.resample(rBuff.writeAddr(), samples, sampleFrames, inputFormat, step));
+			rBuff.commitWrite(bytes);
+			if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites())
+				audioWriteState = AudioWriteState::ACTIVE;
+			return;
+		}
+		// fall back to squeezing the frames into the remaining space below
+		resampler.reset();
+	}
+	else if(speedMultiplier != 1.) [[unlikely]]
 	{
 		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
 		framesToWrite = std::max(framesToWrite, 1zu);
@@ -359,6 +397,25 @@ void EmuAudio::setAddSoundBuffersOnUnderrun(bool on)
 	addSoundBuffersOnUnderrun = on;
 }
 
+void EmuAudio::setDynamicRateControl(bool on)
+{
+	if(dynamicRateControl == on)
+		return;
+	dynamicRateControl = on;
+	resampler.reset();
+}
+
+void EmuAudio::setHashFrames(bool on)
+{
+	hashFrames = on;
+	frameHash = IG::hashSeed;
+}
+
+uint64_t EmuAudio::takeFrameHash()
+{
+	return std::exchange(frameHash, IG::hashSeed);
+}
+
 void EmuAudio::setVolume(int8_t vol)
 {
 	if(vol == 100)
@@ -378,6 +435,13 @@ IG::Audio::Format EmuAudio::format() const
 	return {rate, EmuSystem::audioSampleFormat, channels};
 }
 
+float EmuAudio::bufferFill() const
+{
+	if(!rBuff)
+		return 0;
+	return float(rBuff.size()) / rBuff.capacity();
+}
+
 EmuAudio::operator bool() const
 {
 	return (bool)rBuff;
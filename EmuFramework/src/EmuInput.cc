@@ -40,12 +40,12 @@ void TurboInput::update(EmuApp &app)
 			if(clock == 0)
 			{
 				//logMsg("turbo push for player %d, action %d", e.player, e.action);
-				app.system().handleInputAction(&app, {e, Input::Action::PUSHED});
+				app.handleSystemInput({e, Input::Action::PUSHED});
 			}
 			else if(clock == turboFrames/2)
 			{
 				//logMsg("turbo release for player %d, action %d", e.player, e.action);
-				app.system().handleInputAction(&app, {e, Input::Action::RELEASED});
+				app.handleSystemInput({e, Input::Action::RELEASED});
 			}
 		}
 	}
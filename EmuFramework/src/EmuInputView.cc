@@ -239,6 +239,19 @@ bool EmuInputView::inputEvent(const Input::Event &e)
 						emuApp.viewController().pushAndShowModal(std::move(ynAlertView), e, false);
 						break;
 					}
+					case guiKeyIdxRewind:
+					{
+						if(isRepeated)
+							break;
+						if(isPushed && !emuApp.rewindIsEnabled())
+						{
+							emuApp.postMessage("Rewind is disabled in system options");
+							break;
+						}
+						emuApp.setRewinding(isPushed);
+						logMsg("rewind state:%d", isPushed);
+						break;
+					}
 					default:
 					{
 						if(isRepeated)
@@ -258,7 +271,7 @@ bool EmuInputView::inputEvent(const Input::Event &e)
 								emuApp.removeTurboInputEvent(sysAction);
 							}
 						}
-						sys.handleInputAction(&emuApp, {sysAction, keyEv.state(), keyEv.metaKeyBits()});
+						emuApp.handleSystemInput({sysAction, keyEv.state(), keyEv.metaKeyBits()});
 					}
 				}
 			}
@@ -67,7 +67,11 @@ enum { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_LAYOUT_BEHIND_SYSTEM_UI = 92, CFGKEY_VCONTROLLER_ALLOW_PAST_CONTENT_BOUNDS = 93,
 	CFGKEY_CONTENT_ROTATION = 94, CFGKEY_FORCE_MAX_SCREEN_FRAME_RATE = 95,
 	CFGKEY_VIDEO_BRIGHTNESS = 96, CFGKEY_SCREENSHOTS_PATH = 97,
-	CFGKEY_AUTOSAVE_LAUNCH_MODE = 98,
+	CFGKEY_AUTOSAVE_LAUNCH_MODE = 98, CFGKEY_REWIND_BUFFER_SIZE = 99,
+	CFGKEY_REWIND_INTERVAL = 100, CFGKEY_RUN_AHEAD_FRAMES = 101,
+	CFGKEY_DYNAMIC_RATE_CONTROL = 102, CFGKEY_CACHE_EXTRACTED_CONTENT = 103,
+	CFGKEY_SCREENSHOT_FORMAT = 104, CFGKEY_LOW_LATENCY_FRAME_PACING = 105,
+	CFGKEY_SKIP_UNCHANGED_VIDEO_ROWS = 106,
 	// 256+ is reserved
 };
 
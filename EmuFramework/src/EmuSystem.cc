@@ -23,11 +23,14 @@
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FSUtils.hh>
 #include <imagine/io/IO.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/input/DragTracker.hh>
 #include <imagine/util/utility.h>
 #include <imagine/util/math/int.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/string.h>
+#include <imagine/util/hash.hh>
+#include <imagine/util/format.hh>
 #include <algorithm>
 #include <cstring>
 #include "pathUtils.hh"
@@ -412,12 +415,108 @@ void EmuSystem::loadContentFromPath(IG::CStringView pathStr, std::string_view di
 	loadContentFromFile(appContext().openFileUri(path, IOAccessHint::SEQUENTIAL), path, displayName, params, onLoadProgress);
 }
 
+// Archive entries can be stored uncompressed in the cache directory so later launches
+// map the extracted file instead of decompressing it again. Cache files are keyed by the
+// archive's path, size, last write time, and the entry's CRC so changed archives miss.
+// Cache hits update the file's last write time so trimming evicts the least recently used.
+static constexpr std::uintmax_t extractedContentCacheCapacity = 1024 * 1024 * 1024;
+
+static FS::PathString extractedContentCacheDir(ApplicationContext ctx)
+{
+	return FS::pathString(ctx.cachePath(), "extractedContent");
+}
+
+static FS::PathString extractedContentCachePath(ApplicationContext ctx, CStringView archivePath,
+	size_t archiveSize, uint32_t entryCRC)
+{
+	auto key = fmt::format("{}\n{}\n{}\n{:08x}", archivePath, archiveSize,
+		ctx.fileUriLastWriteTime(archivePath).count(), entryCRC);
+	auto hash = hashBytes({(const unsigned char*)key.data(), key.size()});
+	return FS::pathString(extractedContentCacheDir(ctx), fmt::format("{:016x}", hash));
+}
+
+static void trimExtractedContentCache(CStringView cacheDir)
+{
+	struct CacheFile
+	{
+		FS::PathString path;
+		std::uintmax_t size;
+		FS::file_time_type time;
+	};
+	std::vector<CacheFile> files;
+	std::uintmax_t totalSize{};
+	try
+	{
+		for(auto &entry : FS::directory_iterator{cacheDir})
+		{
+			auto status = FS::status(entry.path());
+			files.emplace_back(entry.path(), status.size(), status.lastWriteTime());
+			totalSize += status.size();
+		}
+	}
+	catch(...)
+	{
+		return;
+	}
+	if(totalSize <= extractedContentCacheCapacity)
+		return;
+	// remove the least recently used extracted files first
+	std::ranges::sort(files, {}, &CacheFile::time);
+	for(const auto &f : files)
+	{
+		if(totalSize <= extractedContentCacheCapacity)
+			break;
+		logMsg("removing cached content:%s", f.path.data());
+		FS::remove(f.path);
+		totalSize -= f.size;
+	}
+}
+
+static IO openCachedArchiveEntry(CStringView cachePath, size_t size)
+{
+	if(FileIO file{cachePath, IOAccessHint::ALL, OpenFlagsMask::TEST};
+		file && file.size() == size)
+	{
+		logMsg("using cached content:%s", cachePath.data());
+		FS::touch(cachePath);
+		return file;
+	}
+	return {};
+}
+
+static IO extractArchiveEntry(ApplicationContext ctx, ArchiveIO entryIO, CStringView cachePath)
+{
+	auto buff = entryIO.buffer(IOBufferMode::RELEASE);
+	if(!buff)
+		return {};
+	if(cachePath.size())
+	{
+		auto cacheDir = extractedContentCacheDir(ctx);
+		FS::create_directory(cacheDir);
+		auto tempPath = FS::PathString{cachePath} + ".tmp";
+		if(FileUtils::writeToPath(tempPath, {buff.data(), buff.size()}) != (ssize_t)buff.size() ||
+			!FS::rename(tempPath, cachePath))
+		{
+			logErr("error writing cached content:%s", cachePath.data());
+			FS::remove(tempPath);
+		}
+		else
+		{
+			trimExtractedContentCache(cacheDir);
+		}
+	}
+	return MapIO{std::move(buff)};
+}
+
 void EmuSystem::loadContentFromFile(IO file, IG::CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	if(EmuApp::hasArchiveExtension(displayName))
 	{
 		IO io{};
 		FS::FileString originalName{};
+		auto ctx = appContext();
+		size_t archiveSize = file.size();
+		bool useCache = EmuApp::get(ctx).cacheExtractedContentOption() && archiveSize && ctx.cachePath().size();
 		for(auto &entry : FS::ArchiveIterator{std::move(file)})
 		{
 			if(entry.type() == FS::file_type::directory)
@@ -429,7 +528,17 @@ void EmuSystem::loadContentFromFile(IO file, IG::CStringView path, std::string_v
 			if(EmuSystem::defaultFsFilter(name))
 			{
 				originalName = name;
-				io = entry.moveIO();
+				if(useCache)
+				{
+					auto cachePath = extractedContentCachePath(ctx, path, archiveSize, entry.crc32());
+					io = openCachedArchiveEntry(cachePath, entry.size());
+					if(!io)
+						io = extractArchiveEntry(ctx, entry.moveIO(), cachePath);
+				}
+				else
+				{
+					io = entry.moveIO();
+				}
 				break;
 			}
 		}
@@ -498,6 +607,22 @@ FS::FileString EmuSystem::contentDisplayNameForPathDefaultImpl(IG::CStringView p
 	return FS::FileString{IG::withoutDotExtension(appContext().fileUriDisplayName(path))};
 }
 
+void EmuSystem::loadStateDefaultImpl(IG::CStringView uri)
+{
+	auto buff = FileUtils::bufferFromUri(appContext(), uri);
+	if(!buff)
+		throwFileReadError();
+	readState(buff.span());
+}
+
+void EmuSystem::saveStateDefaultImpl(IG::CStringView path)
+{
+	IG::ByteBuffer buff{stateSize()};
+	auto size = writeState(buff.span());
+	if(FileUtils::writeToUri(appContext(), path, {buff.data(), size}) == -1)
+		throwFileWriteError();
+}
+
 void EmuSystem::setInitialLoadPath(IG::CStringView path)
 {
 	assert(contentName_.empty());
@@ -77,6 +77,11 @@ static std::string saveAutosaveName(EmuApp &app)
 		std::chrono::duration_cast<Seconds>(app.nextAutosaveTimerFireTime()));
 }
 
+static const char *inputRecordingName(EmuApp &app)
+{
+	return app.inputRecorder().isRecording() ? "Stop Input Recording" : "Start Input Recording";
+}
+
 void EmuSystemActionsView::onShow()
 {
 	if(app().viewController().isShowingEmulation())
@@ -89,6 +94,7 @@ void EmuSystemActionsView::onShow()
 	autosaveNow.setActive(app().currentAutosave() != noAutosaveName);
 	revertAutosave.setActive(app().currentAutosave() != noAutosaveName);
 	resetSessionOptions.setActive(app().hasSavedSessionOptions());
+	inputRecording.compile(inputRecordingName(app()), renderer(), projP);
 }
 
 void EmuSystemActionsView::loadStandardItems()
@@ -105,6 +111,7 @@ void EmuSystemActionsView::loadStandardItems()
 	if(used(addLauncherIcon))
 		item.emplace_back(&addLauncherIcon);
 	item.emplace_back(&screenshot);
+	item.emplace_back(&inputRecording);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
@@ -244,6 +251,30 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 			pushAndShowModal(std::move(ynAlertView), e);
 		}
 	},
+	inputRecording
+	{
+		inputRecordingName(app()), &defaultFace(),
+		[this](const Input::Event &e)
+		{
+			if(!system().hasContent())
+				return;
+			if(app().inputRecorder().isRecording())
+			{
+				app().stopInputRecording();
+				inputRecording.compile(inputRecordingName(app()), renderer(), projP);
+				return;
+			}
+			auto ynAlertView = makeView<YesNoAlertView>(
+				"Start recording input from the current state? The recording stops if a state is loaded or rewind is used.");
+			ynAlertView->setOnYes(
+				[this]()
+				{
+					if(app().startInputRecording())
+						app().showEmulation();
+				});
+			pushAndShowModal(std::move(ynAlertView), e);
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options", &defaultFace(),
@@ -34,51 +34,44 @@ void EmuSystemTask::start()
 	taskThread = IG::makeThreadSync(
 		[this](auto &sem)
 		{
-			auto eventLoop = IG::EventLoop::makeForThread();
-			bool started = true;
-			commandPort.attach(eventLoop,
-				[this, &started](auto msgs)
+			sem.release();
+			logMsg("starting thread message loop");
+			while(true)
+			{
+				for(auto msg : commandPort.waitForMessages())
 				{
-					for(auto msg : msgs)
+					switch(msg.command)
 					{
-						switch(msg.command)
+						case Command::RUN_FRAME:
+						{
+							auto frames = msg.args.run.frames;
+							assumeExpr(frames);
+							//logMsg("running %d frame(s)", frames);
+							auto timer = app().frameProfiler().time(FrameProfiler::Stat::EMULATE);
+							app().runFrames({this, msg.semPtr}, msg.args.run.video, msg.args.run.audio,
+								frames, msg.args.run.skipForward);
+							break;
+						}
+						case Command::PAUSE:
+						{
+							//logMsg("got pause command");
+							assumeExpr(msg.semPtr);
+							msg.semPtr->release();
+							break;
+						}
+						case Command::EXIT:
+						{
+							//logMsg("got exit command");
+							logMsg("exiting thread");
+							return;
+						}
+						default:
 						{
-							case Command::RUN_FRAME:
-							{
-								auto frames = msg.args.run.frames;
-								assumeExpr(frames);
-								//logMsg("running %d frame(s)", frames);
-								app().runFrames({this, msg.semPtr}, msg.args.run.video, msg.args.run.audio,
-									frames, msg.args.run.skipForward);
-								break;
-							}
-							case Command::PAUSE:
-							{
-								//logMsg("got pause command");
-								assumeExpr(msg.semPtr);
-								msg.semPtr->release();
-								break;
-							}
-							case Command::EXIT:
-							{
-								//logMsg("got exit command");
-								started = false;
-								IG::EventLoop::forThread().stop();
-								return false;
-							}
-							default:
-							{
-								logWarn("unknown CommandMessage value:%d", (int)msg.command);
-							}
+							logWarn("unknown CommandMessage value:%d", (int)msg.command);
 						}
 					}
-					return true;
-				});
-			sem.release();
-			logMsg("starting thread event loop");
-			eventLoop.run(started);
-			logMsg("exiting thread");
-			commandPort.detach();
+				}
+			}
 		});
 }
 
@@ -139,15 +132,6 @@ void EmuSystemTask::sendFrameFinishedReply(EmuVideo &video, std::binary_semaphor
 	}
 }
 
-void EmuSystemTask::sendScreenshotReply(bool success)
-{
-	app().runOnMainThread(
-		[=](IG::ApplicationContext ctx)
-		{
-			EmuApp::get(ctx).printScreenshotResult(success);
-		});
-}
-
 EmuApp &EmuSystemTask::app() const
 {
 	return *appPtr;
@@ -19,11 +19,26 @@
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/RendererCommands.hh>
+#include <imagine/util/hash.hh>
 #include <imagine/logger/logger.h>
 
 namespace EmuEx
 {
 
+static uint64_t hashPixmap(IG::PixmapView pix)
+{
+	// hash each line, ignoring any pitch padding
+	uint64_t hash = IG::hashSeed;
+	size_t lineBytes = pix.format().pixelBytes(pix.w());
+	auto data = (const unsigned char*)pix.data();
+	for([[maybe_unused]] auto y : iotaCount(pix.h()))
+	{
+		hash = IG::hashBytes({data, lineBytes}, hash);
+		data += pix.pitchBytes();
+	}
+	return hash;
+}
+
 void EmuVideo::resetImage(IG::PixelFormat newFmt)
 {
 	if(!vidImg)
@@ -38,6 +53,7 @@ void EmuVideo::resetImage(IG::PixelFormat newFmt)
 
 IG::PixmapDesc EmuVideo::deleteImage()
 {
+	resetChangedRows();
 	auto desc = vidImg.pixmapDesc();
 	vidImg = {};
 	return desc;
@@ -76,6 +92,7 @@ bool EmuVideo::setFormat(IG::PixmapDesc desc, EmuSystemTaskContext taskCtx)
 	{
 		vidImg.setFormat(desc, colSpace, samplerConfig());
 	}
+	resetChangedRows();
 	logMsg("resized to:%dx%d", desc.w(), desc.h());
 	if(taskCtx)
 	{
@@ -95,6 +112,7 @@ void EmuVideo::dispatchFormatChanged()
 
 void EmuVideo::syncImageAccess()
 {
+	auto timer = app().frameProfiler().time(FrameProfiler::Stat::FENCE_WAIT);
 	rTask->clientWaitSync(std::exchange(fence, {}));
 }
 
@@ -166,7 +184,16 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffe
 	{
 		doScreenshot(taskCtx, texBuff.pixmap());
 	}
-	vidImg.unlock(texBuff);
+	if(hashFrames) [[unlikely]]
+	{
+		lastFrameHash = hashPixmap(texBuff.pixmap());
+	}
+	// the texture is written directly so the row hashes no longer match its contents
+	resetChangedRows();
+	{
+		auto timer = app().frameProfiler().time(FrameProfiler::Stat::UPLOAD);
+		vidImg.unlock(texBuff);
+	}
 	postFrameFinished(taskCtx);
 }
 
@@ -176,11 +203,62 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 	{
 		doScreenshot(taskCtx, pix);
 	}
+	if(hashFrames) [[unlikely]]
+	{
+		lastFrameHash = hashPixmap(pix);
+	}
+	if(skipUnchangedRows)
+	{
+		auto [firstRow, endRow] = updateChangedRows(pix);
+		if(firstRow == endRow)
+		{
+			startUnchangedFrame(taskCtx);
+			return;
+		}
+		// a single partial upload only pays off when a good part of the frame is unchanged
+		if(endRow - firstRow <= pix.h() * 3 / 4)
+		{
+			syncImageAccess();
+			auto timer = app().frameProfiler().time(FrameProfiler::Stat::UPLOAD);
+			if(vidImg.writeRows(pix.subView({0, firstRow}, {pix.w(), endRow - firstRow}), firstRow, vidImg.WRITE_FLAG_ASYNC))
+			{
+				postFrameFinished(taskCtx);
+				return;
+			}
+		}
+	}
 	syncImageAccess();
-	vidImg.write(pix, vidImg.WRITE_FLAG_ASYNC);
+	{
+		auto timer = app().frameProfiler().time(FrameProfiler::Stat::UPLOAD);
+		vidImg.write(pix, vidImg.WRITE_FLAG_ASYNC);
+	}
 	postFrameFinished(taskCtx);
 }
 
+std::pair<int, int> EmuVideo::updateChangedRows(IG::PixmapView pix)
+{
+	// compare each row's hash to the last uploaded frame, returning the range of rows that changed
+	int rows = pix.h();
+	bool hasPrevHashes = rowHashes.size() == size_t(rows);
+	if(!hasPrevHashes)
+		rowHashes.resize(rows);
+	size_t rowBytes = pix.format().pixelBytes(pix.w());
+	int firstRow = rows, endRow = 0;
+	for(auto y : iotaCount(rows))
+	{
+		auto hash = IG::hashBytes({(const unsigned char*)pix.pixel({0, y}), rowBytes});
+		if(!hasPrevHashes || hash != rowHashes[y])
+		{
+			rowHashes[y] = hash;
+			firstRow = std::min(firstRow, y);
+			endRow = y + 1;
+		}
+	}
+	if(firstRow == rows)
+		return {};
+	return {firstRow, endRow};
+}
+
 bool EmuVideo::addFence(Gfx::RendererCommands &cmds)
 {
 	if(!needsFence)
@@ -191,6 +269,7 @@ bool EmuVideo::addFence(Gfx::RendererCommands &cmds)
 
 void EmuVideo::clear()
 {
+	resetChangedRows();
 	if(!vidImg)
 		return;
 	vidImg.clear();
@@ -201,18 +280,23 @@ void EmuVideo::takeGameScreenshot()
 	screenshotNextFrame = true;
 }
 
-void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
+void EmuVideo::setSkipUnchangedRows(bool on)
+{
+	skipUnchangedRows = on;
+	resetChangedRows();
+}
+
+void EmuVideo::setHashFrames(bool on)
+{
+	hashFrames = on;
+	lastFrameHash = {};
+}
+
+void EmuVideo::doScreenshot(EmuSystemTaskContext, IG::PixmapView pix)
 {
 	screenshotNextFrame = false;
-	auto success = app().writeScreenshot(pix, app().makeNextScreenshotFilename());
-	if(taskCtx)
-	{
-		taskCtx.task().sendScreenshotReply(success);
-	}
-	else
-	{
-		app().printScreenshotResult(success);
-	}
+	// the result is posted to the main thread once the frame is encoded
+	app().queueScreenshot(pix);
 }
 
 bool EmuVideo::isExternalTexture() const
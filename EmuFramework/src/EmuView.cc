@@ -16,7 +16,10 @@
 #include <emuframework/EmuView.hh>
 #include <emuframework/EmuVideoLayer.hh>
 #include <emuframework/EmuSystem.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/gfx/GeomQuad.hh>
 #include <imagine/input/Input.hh>
+#include <imagine/util/format.hh>
 #include <algorithm>
 
 namespace EmuEx
@@ -30,6 +33,11 @@ EmuView::EmuView(ViewAttachParams attach, EmuVideoLayer *layer, EmuSystem &sys):
 	sysPtr{&sys}
 {}
 
+constexpr size_t graphSamples = 120;
+constexpr int statsTextUpdateInterval = 30;
+
+static FrameProfiler &frameProfiler(ApplicationContext ctx) { return EmuApp::get(ctx).frameProfiler(); }
+
 void EmuView::prepareDraw()
 {
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
@@ -44,6 +52,10 @@ void EmuView::draw(Gfx::RendererCommands &__restrict__ cmds)
 	{
 		layer->draw(cmds, projP);
 	}
+	if(frameProfiler(appContext()).isEnabled()) [[unlikely]]
+	{
+		drawFrameTimeStats(cmds);
+	}
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 	if(audioStatsText.isVisible())
 	{
@@ -101,4 +113,110 @@ void EmuView::clearAudioStats()
 	#endif
 }
 
+void EmuView::updateFrameTimeStats()
+{
+	if(--framesUntilStatsTextUpdate > 0)
+		return;
+	framesUntilStatsTextUpdate = statsTextUpdateInterval;
+	std::array<FrameProfiler::Sample, graphSamples> samples;
+	auto count = frameProfiler(appContext()).recentSamples(samples);
+	if(!count)
+		return;
+	using Stat = FrameProfiler::Stat;
+	std::array<double, FrameProfiler::statCount> avgMSecs{};
+	double avgAudioFill{};
+	for(const auto &s : std::span{samples.data(), count})
+	{
+		for(auto i : iotaCount(FrameProfiler::statCount))
+		{
+			avgMSecs[i] += std::chrono::duration<double, std::milli>(s.duration[i]).count();
+		}
+		avgAudioFill += s.audioFillPercent;
+	}
+	for(auto &t : avgMSecs) { t /= count; }
+	avgAudioFill /= count;
+	if(!frameTimeStatsText.face())
+		frameTimeStatsText.setFace(&defaultFace());
+	frameTimeStatsText.resetString(fmt::format("Emulate: {:.2f}ms\nUpload: {:.2f}ms\nFence Wait: {:.2f}ms\nDraw: {:.2f}ms\nAudio Fill: {:.0f}%",
+		avgMSecs[size_t(Stat::EMULATE)], avgMSecs[size_t(Stat::UPLOAD)], avgMSecs[size_t(Stat::FENCE_WAIT)],
+		avgMSecs[size_t(Stat::DRAW)], avgAudioFill));
+	frameTimeStatsText.makeGlyphs(renderer());
+	frameTimeStatsText.compile(renderer(), projP);
+}
+
+void EmuView::drawFrameTimeStats(Gfx::RendererCommands &__restrict__ cmds)
+{
+	using namespace IG::Gfx;
+	using Stat = FrameProfiler::Stat;
+	std::array<FrameProfiler::Sample, graphSamples> samples;
+	auto count = frameProfiler(appContext()).recentSamples(samples);
+	int barXSize = std::max(1, viewRect().xSize() / 2 / int(graphSamples));
+	int graphYSize = viewRect().ySize() / 4;
+	auto graphPos = viewRect().pos(LT2DO);
+	// graph spans two frame durations, with a marker line at the frame duration
+	auto frameTime = system().frameTime();
+	auto yScale = graphYSize / (frameTime.count() * 2.);
+	auto toYSize = [&](SteadyClockTime t)
+	{
+		return std::min(int(std::chrono::duration<double>(t).count() * yScale), graphYSize);
+	};
+	auto &basicEffect = cmds.basicEffect();
+	basicEffect.disableTexture(cmds);
+	cmds.set(BlendMode::ALPHA);
+	cmds.setColor(0., 0., 0., .6);
+	auto bgRect = makeWindowRectRel(graphPos, {barXSize * int(graphSamples), graphYSize});
+	GeomRect::draw(cmds, bgRect, projP);
+	const std::array colors
+	{
+		VertexColorPixelFormat.build(.2, .8, .2, 1.), // emulation excluding upload & fence
+		VertexColorPixelFormat.build(.2, .4, 1., 1.),
+		VertexColorPixelFormat.build(1., .8, .2, 1.),
+		VertexColorPixelFormat.build(.8, .2, .8, 1.),
+	};
+	// quads are indexed with 8-bit values so draw in batches of 64
+	StaticArrayList<ColQuad, 64> quads;
+	StaticArrayList<std::array<VertexIndex, 6>, quads.capacity()> quadIdxs;
+	cmds.set(BlendMode::OFF);
+	cmds.set(ColorName::WHITE);
+	auto flush = [&]()
+	{
+		if(quads.empty())
+			return;
+		drawQuads(cmds, quads, quadIdxs);
+		quads.clear();
+		quadIdxs.clear();
+	};
+	auto addSegment = [&](int x, int &yBottom, int ySize, VertexColor color)
+	{
+		if(ySize <= 0)
+			return;
+		if(quads.size() == quads.capacity())
+			flush();
+		quadIdxs.emplace_back(makeRectIndexArray(quads.size()));
+		quads.emplace_back(projP.unProjectRect(makeWindowRectRel({x, yBottom - ySize}, {barXSize, ySize})), color);
+		yBottom -= ySize;
+	};
+	int x = graphPos.x + barXSize * int(graphSamples - count);
+	for(const auto &s : std::span{samples.data(), count})
+	{
+		int yBottom = graphPos.y + graphYSize;
+		auto emulateOnly = s.time(Stat::EMULATE) - s.time(Stat::UPLOAD) - s.time(Stat::FENCE_WAIT);
+		addSegment(x, yBottom, toYSize(emulateOnly), colors[0]);
+		addSegment(x, yBottom, toYSize(s.time(Stat::UPLOAD)), colors[1]);
+		addSegment(x, yBottom, toYSize(s.time(Stat::FENCE_WAIT)), colors[2]);
+		addSegment(x, yBottom, toYSize(s.time(Stat::DRAW)), colors[3]);
+		x += barXSize;
+	}
+	flush();
+	cmds.setColor(1., 0., 0., 1.);
+	GeomRect::draw(cmds, makeWindowRectRel({graphPos.x, graphPos.y + graphYSize / 2}, {barXSize * int(graphSamples), 1}), projP);
+	if(frameTimeStatsText.isVisible())
+	{
+		cmds.setColor(1., 1., 1., 1.);
+		basicEffect.enableAlphaTexture(cmds);
+		frameTimeStatsText.draw(cmds, projP.unProjectRect(makeWindowRectRel({graphPos.x, graphPos.y + graphYSize}, {1, 1})).pos(LT2DO),
+			LT2DO, projP);
+	}
+}
+
 }
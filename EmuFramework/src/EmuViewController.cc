@@ -296,6 +296,11 @@ void EmuViewController::updateEmuAudioStats(int underruns, int overruns, int cal
 	emuView.updateAudioStats(underruns, overruns, callbacks, avgCallbackFrames, frames);
 }
 
+void EmuViewController::updateFrameTimeStats()
+{
+	emuView.updateFrameTimeStats();
+}
+
 void EmuViewController::clearEmuAudioStats()
 {
 	emuView.clearAudioStats();
@@ -359,6 +364,8 @@ bool EmuViewController::drawMainWindow(IG::Window &win, IG::WindowDrawParams par
 	return task.draw(win, params, {},
 		[this](IG::Window &win, Gfx::RendererCommands &cmds)
 	{
+		auto timer = app().frameProfiler().time(FrameProfiler::Stat::DRAW);
+		auto drawStart = IG::steadyClockTimestamp();
 		cmds.clear();
 		auto &winData = windowData(win);
 		cmds.basicEffect().setModelViewProjection(cmds, winData.projection);
@@ -371,6 +378,9 @@ bool EmuViewController::drawMainWindow(IG::Window &win, IG::WindowDrawParams par
 			emuInputView.draw(cmds);
 			if(winData.hasPopup)
 				popup.draw(cmds);
+			// exclude present since it may block until vsync
+			if(app().lowLatencyFramePacing())
+				app().framePacer().addDrawTime(IG::steadyClockTimestamp() - drawStart);
 		}
 		else
 		{
@@ -0,0 +1,81 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "FramePacer"
+#include <emuframework/FramePacer.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+
+namespace EmuEx
+{
+
+static void updateEstimate(double &estimate, SteadyClockTime sample)
+{
+	// track increases quickly so a run of expensive frames doesn't keep missing deadlines
+	double ns = sample.count();
+	estimate += (ns - estimate) * (ns > estimate ? .5 : 1. / 16.);
+}
+
+SteadyClockTime FramePacer::startDelay(SteadyClockTime now, SteadyClockTime deadline, FloatSeconds frameTime) const
+{
+	if(!emulateNs)
+		return {}; // no estimate yet
+	auto delay = deadline - frameCost() - now;
+	// a delay outside the frame means the frame clock isn't in the steady clock's time base or emulation can't keep up
+	if(delay < minDelay || delay > std::chrono::duration_cast<SteadyClockTime>(frameTime))
+		return {};
+	return delay;
+}
+
+void FramePacer::addFrame(SteadyClockTime emulateTime, SteadyClockTime readyTime, SteadyClockTime deadline)
+{
+	updateEstimate(emulateNs, emulateTime);
+	if(readyTime + SteadyClockTime{SteadyClockTime::rep(drawNs.load(std::memory_order_relaxed))} > deadline)
+	{
+		addMissedStart();
+	}
+	else
+	{
+		marginNs = std::max(marginNs * .99, double(SteadyClockTime{minMargin}.count()));
+	}
+}
+
+void FramePacer::addDrawTime(SteadyClockTime t)
+{
+	auto estimate = drawNs.load(std::memory_order_relaxed);
+	updateEstimate(estimate, t);
+	drawNs.store(estimate, std::memory_order_relaxed);
+}
+
+void FramePacer::addMissedStart()
+{
+	constexpr double maxMarginNs = std::chrono::nanoseconds{std::chrono::milliseconds{8}}.count();
+	marginNs = std::min(marginNs * 2., maxMarginNs);
+	logDMsg("frame missed deadline, margin now:%.2fms", marginNs / 1e6);
+}
+
+void FramePacer::reset()
+{
+	emulateNs = {};
+	drawNs.store({}, std::memory_order_relaxed);
+	marginNs = SteadyClockTime{minMargin}.count();
+}
+
+SteadyClockTime FramePacer::frameCost() const
+{
+	return SteadyClockTime{SteadyClockTime::rep(emulateNs + drawNs.load(std::memory_order_relaxed) + marginNs)};
+}
+
+}
@@ -0,0 +1,161 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "FrameProfiler"
+#include <emuframework/FrameProfiler.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <string>
+
+namespace EmuEx
+{
+
+void FrameProfiler::setEnabled(bool on)
+{
+	if(on == isEnabled())
+		return;
+	clear();
+	enabled.store(on, std::memory_order_relaxed);
+	logMsg("%s frame time stats", on ? "enabled" : "disabled");
+}
+
+void FrameProfiler::beginFrame(int framesAdvanced, float audioFill)
+{
+	std::scoped_lock lock{mutex};
+	if(hasCurrent)
+	{
+		for(auto i : iotaCount(statCount))
+		{
+			current.start[i] = SteadyClockTime{(SteadyClockTime::rep)pendingStart[i].exchange(0, std::memory_order_relaxed)};
+			current.duration[i] = SteadyClockTime{(SteadyClockTime::rep)pendingDuration[i].exchange(0, std::memory_order_relaxed)};
+		}
+		if(samples.size() < maxSamples)
+		{
+			samples.emplace_back(current);
+		}
+		else
+		{
+			samples[nextSampleIdx] = current;
+		}
+		nextSampleIdx = (nextSampleIdx + 1) % maxSamples;
+	}
+	current = {};
+	current.timestamp = steadyClockTimestamp();
+	current.framesAdvanced = std::min(framesAdvanced, 127);
+	current.audioFillPercent = std::clamp(audioFill, 0.f, 1.f) * 100.f;
+	hasCurrent = true;
+}
+
+void FrameProfiler::add(Stat stat, SteadyClockTime start, SteadyClockTime end)
+{
+	auto idx = size_t(stat);
+	SteadyClockTime::rep expected = 0;
+	pendingStart[idx].compare_exchange_strong(expected, start.count(), std::memory_order_relaxed);
+	pendingDuration[idx].fetch_add((end - start).count(), std::memory_order_relaxed);
+}
+
+void FrameProfiler::clear()
+{
+	std::scoped_lock lock{mutex};
+	samples.clear();
+	nextSampleIdx = 0;
+	hasCurrent = false;
+	for(auto i : iotaCount(statCount))
+	{
+		pendingStart[i].store(0, std::memory_order_relaxed);
+		pendingDuration[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t FrameProfiler::recentSamples(std::span<Sample> dest) const
+{
+	std::scoped_lock lock{mutex};
+	if(samples.empty())
+		return 0;
+	auto count = std::min(dest.size(), samples.size());
+	// the oldest sample is at nextSampleIdx once the buffer wraps
+	auto firstIdx = (nextSampleIdx + samples.size() - count) % samples.size();
+	for(auto i : iotaCount(count))
+	{
+		dest[i] = samples[(firstIdx + i) % samples.size()];
+	}
+	return count;
+}
+
+size_t FrameProfiler::size() const
+{
+	std::scoped_lock lock{mutex};
+	return samples.size();
+}
+
+static constexpr const char *statName(FrameProfiler::Stat stat)
+{
+	using enum FrameProfiler::Stat;
+	switch(stat)
+	{
+		case EMULATE: return "Emulate";
+		case UPLOAD: return "Texture Upload";
+		case FENCE_WAIT: return "Fence Wait";
+		case DRAW: return "Draw & Present";
+	}
+	return "";
+}
+
+static constexpr int statThreadId(FrameProfiler::Stat stat)
+{
+	return stat == FrameProfiler::Stat::DRAW ? 3 : 2;
+}
+
+bool FrameProfiler::writeChromeTrace(CStringView path) const
+{
+	std::vector<Sample> sampleCopy(maxSamples);
+	sampleCopy.resize(recentSamples(sampleCopy));
+	if(sampleCopy.empty())
+		return false;
+	auto toUSecs = [](SteadyClockTime t){ return std::chrono::duration<double, std::micro>(t).count(); };
+	std::string json{"{\"traceEvents\":[\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}},\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Emulation\"}},\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Renderer\"}}"};
+	for(const auto &s : sampleCopy)
+	{
+		auto ts = toUSecs(s.timestamp);
+		json += fmt::format(",\n{{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},"
+			"\"args\":{{\"framesAdvanced\":{}}}}}", ts, s.framesAdvanced);
+		json += fmt::format(",\n{{\"name\":\"Audio Fill %\",\"ph\":\"C\",\"pid\":1,\"ts\":{:.3f},\"args\":{{\"fill\":{}}}}}",
+			ts, s.audioFillPercent);
+		for(auto i : iotaCount(statCount))
+		{
+			if(s.start[i] == SteadyClockTime{})
+				continue;
+			auto stat = Stat(i);
+			json += fmt::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+				statName(stat), statThreadId(stat), toUSecs(s.start[i]), toUSecs(s.duration[i]));
+		}
+	}
+	json += "\n]}\n";
+	if(FileUtils::writeToPath(path, {(const unsigned char*)json.data(), json.size()}) != (ssize_t)json.size())
+	{
+		logErr("error writing trace:%s", path.data());
+		return false;
+	}
+	logMsg("wrote trace with %zu frames:%s", sampleCopy.size(), path.data());
+	return true;
+}
+
+}
@@ -0,0 +1,174 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputRecorder"
+#include <emuframework/InputRecorder.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+// File format: [8-byte magic][32-bit frame count][32-bit event count][32-bit state size][state]
+// followed by each event as LEB128 varints of: frame delta from the previous event,
+// key shifted left once with the pressed flag in the low bit, and meta state
+
+constexpr char fileMagic[8]{'E', 'm', 'u', 'E', 'x', 'I', 'R', '1'};
+constexpr size_t headerSize = sizeof(fileMagic) + sizeof(uint32_t) * 3;
+
+static void writeVarint(std::vector<uint8_t> &out, uint32_t val)
+{
+	while(val >= 0x80)
+	{
+		out.push_back(uint8_t(val | 0x80));
+		val >>= 7;
+	}
+	out.push_back(uint8_t(val));
+}
+
+static uint32_t readVarint(std::span<const uint8_t> &in)
+{
+	uint32_t val{};
+	for(int shift = 0; shift < 35; shift += 7)
+	{
+		if(in.empty())
+			throw std::runtime_error{"Input recording is truncated"};
+		auto byte = in.front();
+		in = in.subspan(1);
+		val |= uint32_t(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return val;
+	}
+	throw std::runtime_error{"Input recording has an invalid value"};
+}
+
+static void writeU32(std::vector<uint8_t> &out, uint32_t val)
+{
+	auto bytes = reinterpret_cast<const uint8_t*>(&val);
+	out.insert(out.end(), bytes, bytes + sizeof(val));
+}
+
+static uint32_t readU32(std::span<const uint8_t> &in)
+{
+	uint32_t val;
+	memcpy(&val, in.data(), sizeof(val));
+	in = in.subspan(sizeof(val));
+	return val;
+}
+
+InputRecording InputRecording::read(std::span<const uint8_t> data)
+{
+	if(data.size() < headerSize || memcmp(data.data(), fileMagic, sizeof(fileMagic)) != 0)
+		throw std::runtime_error{"Not an input recording"};
+	data = data.subspan(sizeof(fileMagic));
+	InputRecording rec;
+	rec.frames = readU32(data);
+	auto eventCount = readU32(data);
+	auto stateSize = readU32(data);
+	if(rec.frames < 0 || data.size() < stateSize || eventCount > data.size() - stateSize)
+		throw std::runtime_error{"Input recording is truncated"};
+	rec.state = ByteBuffer{stateSize};
+	memcpy(rec.state.data(), data.data(), stateSize);
+	data = data.subspan(stateSize);
+	rec.events.reserve(eventCount);
+	int frame{};
+	for([[maybe_unused]] auto i : iotaCount(eventCount))
+	{
+		frame += readVarint(data);
+		auto keyAndPressed = readVarint(data);
+		auto metaState = readVarint(data);
+		if(frame > rec.frames)
+			throw std::runtime_error{"Input recording has an event past its end"};
+		rec.events.emplace_back(frame, keyAndPressed >> 1, bool(keyAndPressed & 1), metaState);
+	}
+	return rec;
+}
+
+std::vector<uint8_t> InputRecording::write() const
+{
+	std::vector<uint8_t> out;
+	out.reserve(headerSize + state.size() + events.size() * 4);
+	out.insert(out.end(), std::begin(fileMagic), std::end(fileMagic));
+	writeU32(out, frames);
+	writeU32(out, events.size());
+	writeU32(out, state.size());
+	out.insert(out.end(), state.data(), state.data() + state.size());
+	int prevFrame{};
+	for(const auto &e : events)
+	{
+		writeVarint(out, e.frame - prevFrame);
+		writeVarint(out, (e.key << 1) | e.pressed);
+		writeVarint(out, e.metaState);
+		prevFrame = e.frame;
+	}
+	return out;
+}
+
+void InputRecorder::start(EmuSystem &sys)
+{
+	auto size = sys.stateSize();
+	if(!size)
+		throw std::runtime_error{"System doesn't support memory save states"};
+	auto buff = std::make_unique<uint8_t[]>(size);
+	auto written = sys.writeState({buff.get(), size});
+	std::scoped_lock lock{mutex};
+	state = ByteBuffer{std::move(buff), written};
+	events.clear();
+	frame.store(0, std::memory_order_relaxed);
+	recording.store(true, std::memory_order_relaxed);
+	logMsg("started recording with %zu byte state", state.size());
+}
+
+InputRecording InputRecorder::stop()
+{
+	std::scoped_lock lock{mutex};
+	recording.store(false, std::memory_order_relaxed);
+	InputRecording rec{std::move(state), std::move(events), frame.load(std::memory_order_relaxed)};
+	events = {};
+	logMsg("stopped recording after %d frames with %zu events", rec.frames, rec.events.size());
+	return rec;
+}
+
+void InputRecorder::cancel()
+{
+	if(!isRecording())
+		return;
+	std::scoped_lock lock{mutex};
+	recording.store(false, std::memory_order_relaxed);
+	state = {};
+	events = {};
+	logMsg("canceled recording");
+}
+
+void InputRecorder::record(InputAction action)
+{
+	if(!isRecording() || (action.state != Input::Action::PUSHED && action.state != Input::Action::RELEASED))
+		return;
+	std::scoped_lock lock{mutex};
+	if(!isRecording())
+		return;
+	// actions from the main thread can race with frame starts on the emulation thread,
+	// so keep events in frame order in case one lands behind an already logged action
+	InputScriptEvent e{frame.load(std::memory_order_relaxed), action.key, action.state == Input::Action::PUSHED, action.metaState};
+	if(events.size() && events.back().frame > e.frame)
+		e.frame = events.back().frame;
+	events.emplace_back(e);
+}
+
+}
@@ -0,0 +1,299 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Rewind"
+#include <emuframework/RewindManager.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+// Delta format: a series of segments, each with a header of two 32-bit values
+// (words to skip, words to XOR) followed by the XOR words, with 64-bit words.
+// Each history record in the ring buffer is laid out as:
+// [32-bit delta size][32-bit previous state size][delta][32-bit delta size]
+// so records can be removed from either end of the buffer.
+
+using Word = uint64_t;
+constexpr size_t wordSize = sizeof(Word);
+constexpr size_t segmentHeaderSize = sizeof(uint32_t) * 2;
+constexpr size_t recordHeaderSize = sizeof(uint32_t) * 2;
+constexpr size_t recordTrailerSize = sizeof(uint32_t);
+constexpr size_t recordOverhead = recordHeaderSize + recordTrailerSize;
+
+static Word loadWord(const uint8_t *p)
+{
+	Word w;
+	memcpy(&w, p, wordSize);
+	return w;
+}
+
+static void storeWord(uint8_t *p, Word w)
+{
+	memcpy(p, &w, wordSize);
+}
+
+static uint32_t loadU32(const void *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static void storeU32(void *p, uint32_t v)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+static size_t stateCapacity(size_t stateSize)
+{
+	return (stateSize + wordSize - 1) & ~(wordSize - 1);
+}
+
+size_t RewindManager::maxEncodedDeltaSize(size_t stateSize)
+{
+	// worst case is one differing word in every 3, since single equal words are merged into runs
+	return stateCapacity(stateSize) + (stateSize / (wordSize * 3) + 2) * segmentHeaderSize;
+}
+
+size_t RewindManager::encodeDelta(std::span<const uint8_t> prevState, std::span<const uint8_t> state, uint8_t *output)
+{
+	assert(prevState.size() == state.size());
+	assert(!(state.size() % wordSize));
+	const size_t words = state.size() / wordSize;
+	auto prevPtr = prevState.data();
+	auto statePtr = state.data();
+	auto wordsDiffer = [&](size_t i){ return loadWord(prevPtr + i * wordSize) != loadWord(statePtr + i * wordSize); };
+	uint8_t *outPtr = output;
+	size_t i = 0;
+	size_t lastSegmentEnd = 0;
+	while(i < words)
+	{
+		while(i < words && !wordsDiffer(i))
+			i++;
+		if(i == words)
+			break;
+		size_t runStart = i;
+		size_t runEnd = ++i;
+		while(i < words)
+		{
+			if(wordsDiffer(i))
+			{
+				runEnd = ++i;
+			}
+			else if(i + 1 < words && wordsDiffer(i + 1))
+			{
+				// a single equal word costs the same as a new segment header, merge it into the run
+				i += 2;
+				runEnd = i;
+			}
+			else
+			{
+				break;
+			}
+		}
+		storeU32(outPtr, runStart - lastSegmentEnd);
+		storeU32(outPtr + sizeof(uint32_t), runEnd - runStart);
+		outPtr += segmentHeaderSize;
+		for(auto w = runStart; w < runEnd; w++)
+		{
+			storeWord(outPtr, loadWord(prevPtr + w * wordSize) ^ loadWord(statePtr + w * wordSize));
+			outPtr += wordSize;
+		}
+		lastSegmentEnd = runEnd;
+		i = runEnd;
+	}
+	return outPtr - output;
+}
+
+void RewindManager::applyDelta(std::span<uint8_t> state, std::span<const uint8_t> delta)
+{
+	auto statePtr = state.data();
+	auto stateEnd = state.data() + state.size();
+	auto deltaPtr = delta.data();
+	auto deltaEnd = delta.data() + delta.size();
+	while(deltaPtr < deltaEnd)
+	{
+		statePtr += loadU32(deltaPtr) * wordSize;
+		auto copyWords = loadU32(deltaPtr + sizeof(uint32_t));
+		deltaPtr += segmentHeaderSize;
+		assumeExpr(statePtr + copyWords * wordSize <= stateEnd);
+		for(auto w = 0u; w < copyWords; w++)
+		{
+			storeWord(statePtr, loadWord(statePtr) ^ loadWord(deltaPtr));
+			statePtr += wordSize;
+			deltaPtr += wordSize;
+		}
+	}
+}
+
+void RewindManager::setMaxBytes(size_t bytes)
+{
+	if(bytes == maxHistoryBytes)
+		return;
+	maxHistoryBytes = bytes;
+	reset();
+}
+
+void RewindManager::setInterval(int frames)
+{
+	saveInterval = std::max(frames, 1);
+	framesUntilSave = std::min(framesUntilSave, saveInterval);
+}
+
+void RewindManager::reset()
+{
+	history = {};
+	currentState = {};
+	nextState = {};
+	deltaBuff = {};
+	currentStateSize = 0;
+	historyStates = 0;
+	framesUntilSave = 0;
+}
+
+bool RewindManager::initBuffers(EmuSystem &sys)
+{
+	auto size = sys.stateSize();
+	if(!size)
+	{
+		logWarn("system doesn't support memory save states");
+		maxHistoryBytes = 0;
+		return false;
+	}
+	history = IG::RingBuffer{maxHistoryBytes};
+	if(!history)
+	{
+		logErr("error allocating %zu byte history buffer", maxHistoryBytes);
+		maxHistoryBytes = 0;
+		return false;
+	}
+	auto capacity = stateCapacity(size);
+	currentState = IG::ByteBuffer{capacity};
+	nextState = IG::ByteBuffer{capacity};
+	deltaBuff = IG::ByteBuffer{maxEncodedDeltaSize(capacity)};
+	logMsg("allocated %zu byte history buffer for %zu byte states", history.capacity(), size);
+	return true;
+}
+
+void RewindManager::onFrames(EmuSystem &sys, int frames)
+{
+	if(!maxHistoryBytes)
+		return;
+	framesUntilSave -= frames;
+	if(framesUntilSave > 0)
+		return;
+	framesUntilSave = saveInterval;
+	saveState(sys);
+}
+
+void RewindManager::saveState(EmuSystem &sys)
+{
+	bool hasCurrentState = (bool)currentState;
+	if(!hasCurrentState && !initBuffers(sys))
+		return;
+	auto &dest = hasCurrentState ? nextState : currentState;
+	size_t size;
+	try
+	{
+		size = sys.writeState(dest.span());
+	}
+	catch(std::exception &err)
+	{
+		logErr("error saving state:%s", err.what());
+		reset();
+		return;
+	}
+	// keep the padding zeroed so deltas of states with different sizes are exact
+	std::fill(dest.data() + size, dest.data() + dest.size(), 0);
+	if(!hasCurrentState)
+	{
+		currentStateSize = size;
+		return;
+	}
+	auto deltaSize = encodeDelta(currentState.span(), nextState.span(), deltaBuff.data());
+	auto recordSize = deltaSize + recordOverhead;
+	if(recordSize > history.capacity())
+	{
+		logWarn("%zu byte delta too large for history buffer", deltaSize);
+		history.clear();
+		historyStates = 0;
+	}
+	else
+	{
+		while(history.freeSpace() < recordSize)
+		{
+			dropOldestState();
+		}
+		// buffer is mirrored so the record can be written contiguously
+		auto recordPtr = history.writeAddr();
+		storeU32(recordPtr, deltaSize);
+		storeU32(recordPtr + sizeof(uint32_t), currentStateSize);
+		memcpy(recordPtr + recordHeaderSize, deltaBuff.data(), deltaSize);
+		storeU32(recordPtr + recordHeaderSize + deltaSize, deltaSize);
+		history.commitWrite(recordSize);
+		historyStates++;
+	}
+	std::swap(currentState, nextState);
+	currentStateSize = size;
+}
+
+bool RewindManager::loadPrevState(EmuSystem &sys)
+{
+	if(!currentState)
+		return false;
+	bool hasPrevState = historyStates;
+	if(hasPrevState)
+		popNewestState();
+	try
+	{
+		sys.readState({currentState.data(), currentStateSize});
+	}
+	catch(std::exception &err)
+	{
+		logErr("error loading state:%s", err.what());
+		reset();
+		return false;
+	}
+	framesUntilSave = saveInterval;
+	return hasPrevState;
+}
+
+void RewindManager::dropOldestState()
+{
+	assert(historyStates);
+	auto deltaSize = loadU32(history.readAddr());
+	history.commitRead(deltaSize + recordOverhead);
+	historyStates--;
+}
+
+void RewindManager::popNewestState()
+{
+	assert(historyStates);
+	history.uncommitWrite(recordTrailerSize);
+	auto deltaSize = loadU32(history.writeAddr());
+	history.uncommitWrite(deltaSize + recordHeaderSize);
+	auto recordPtr = history.writeAddr();
+	currentStateSize = loadU32(recordPtr + sizeof(uint32_t));
+	applyDelta(currentState.span(), {(const uint8_t*)recordPtr + recordHeaderSize, deltaSize});
+	historyStates--;
+}
+
+}
@@ -0,0 +1,101 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "ScreenshotWriter"
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+
+namespace EmuEx
+{
+
+ScreenshotWriter::~ScreenshotWriter()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+	}
+	cond.notify_all();
+	thread.join();
+}
+
+MemPixmap ScreenshotWriter::takeBuffer(PixmapDesc desc, std::unique_lock<std::mutex> &lock)
+{
+	cond.wait(lock, [&]{ return usedBuffers < maxBuffers; });
+	usedBuffers++;
+	if(auto it = std::ranges::find_if(freeBuffers, [&](auto &b){ return b.desc() == desc; });
+		it != freeBuffers.end())
+	{
+		auto buff = std::move(*it);
+		freeBuffers.erase(it);
+		return buff;
+	}
+	return MemPixmap{desc};
+}
+
+void ScreenshotWriter::write(PixmapView pix, CStringView path, Data::PixmapWriteParams params)
+{
+	std::unique_lock lock{mutex};
+	auto buff = takeBuffer({pix.size(), pix.format()}, lock);
+	lock.unlock();
+	buff.view().write(pix);
+	lock.lock();
+	jobs.emplace_back(std::move(buff), FS::PathString{path}, params);
+	if(!thread.joinable())
+		thread = std::thread{[this]{ run(); }};
+	lock.unlock();
+	cond.notify_all();
+}
+
+void ScreenshotWriter::wait()
+{
+	std::unique_lock lock{mutex};
+	if(!usedBuffers)
+		return;
+	logMsg("waiting for pending screenshot writes");
+	cond.wait(lock, [&]{ return !usedBuffers; });
+}
+
+void ScreenshotWriter::run()
+{
+	std::unique_lock lock{mutex};
+	while(true)
+	{
+		cond.wait(lock, [&]{ return jobs.size() || quit; });
+		if(jobs.empty())
+			return;
+		auto job = std::move(jobs.front());
+		jobs.pop_front();
+		lock.unlock();
+		bool success = writer.writeToFile(job.pix.view(), job.path.data(), job.params);
+		logMsg("%s screenshot:%s", success ? "wrote" : "error writing", job.path.data());
+		lock.lock();
+		// keep only the most recent buffers for reuse
+		if(freeBuffers.size() == maxBuffers)
+			freeBuffers.erase(freeBuffers.begin());
+		freeBuffers.emplace_back(std::move(job.pix));
+		usedBuffers--;
+		cond.notify_all();
+		ctx.runOnMainThread([success](ApplicationContext ctx)
+		{
+			EmuApp::get(ctx).printScreenshotResult(success);
+		});
+	}
+}
+
+}
@@ -39,6 +39,26 @@ TextMenuItem::SelectDelegate SystemOptionView::setFastSlowModeSpeedDel()
 	return [this](TextMenuItem &item) { app().fastSlowModeSpeedOption() = item.id(); };
 }
 
+TextMenuItem::SelectDelegate SystemOptionView::setRewindBufferSizeDel()
+{
+	return [this](TextMenuItem &item) { app().setRewindBufferSizeMB(item.id()); };
+}
+
+TextMenuItem::SelectDelegate SystemOptionView::setRewindIntervalDel()
+{
+	return [this](TextMenuItem &item) { app().setRewindInterval(item.id()); };
+}
+
+TextMenuItem::SelectDelegate SystemOptionView::setRunAheadFramesDel()
+{
+	return [this](TextMenuItem &item) { app().setRunAheadFrames(item.id()); };
+}
+
+TextMenuItem::SelectDelegate SystemOptionView::setScreenshotFormatDel()
+{
+	return [this](TextMenuItem &item) { app().screenshotFormatOption() = item.id(); };
+}
+
 SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 	TableView{"System Options", attach, item},
 	autosaveTimerItem
@@ -120,6 +140,69 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 		(MenuItem::Id)app().fastSlowModeSpeedOption().val,
 		fastSlowModeSpeedItem
 	},
+	rewindBufferSizeItem
+	{
+		{"Off",   &defaultFace(), setRewindBufferSizeDel(), 0},
+		{"16MB",  &defaultFace(), setRewindBufferSizeDel(), 16},
+		{"32MB",  &defaultFace(), setRewindBufferSizeDel(), 32},
+		{"64MB",  &defaultFace(), setRewindBufferSizeDel(), 64},
+		{"128MB", &defaultFace(), setRewindBufferSizeDel(), 128},
+	},
+	rewindBufferSize
+	{
+		"Rewind Buffer Size", &defaultFace(),
+		(MenuItem::Id)app().rewindBufferSizeOption().val,
+		rewindBufferSizeItem
+	},
+	rewindIntervalItem
+	{
+		{"Every Frame",     &defaultFace(), setRewindIntervalDel(), 1},
+		{"Every 2 Frames",  &defaultFace(), setRewindIntervalDel(), 2},
+		{"Every 4 Frames",  &defaultFace(), setRewindIntervalDel(), 4},
+		{"Every 8 Frames",  &defaultFace(), setRewindIntervalDel(), 8},
+	},
+	rewindInterval
+	{
+		"Rewind Snapshot Interval", &defaultFace(),
+		(MenuItem::Id)app().rewindIntervalOption().val,
+		rewindIntervalItem
+	},
+	runAheadFramesItem
+	{
+		{"Off",      &defaultFace(), setRunAheadFramesDel(), 0},
+		{"1 Frame",  &defaultFace(), setRunAheadFramesDel(), 1},
+		{"2 Frames", &defaultFace(), setRunAheadFramesDel(), 2},
+		{"3 Frames", &defaultFace(), setRunAheadFramesDel(), 3},
+		{"4 Frames", &defaultFace(), setRunAheadFramesDel(), 4},
+	},
+	runAheadFrames
+	{
+		"Run-Ahead", &defaultFace(),
+		(MenuItem::Id)app().runAheadFramesOption().val,
+		runAheadFramesItem
+	},
+	cacheExtractedContent
+	{
+		"Cache Extracted Archives", &defaultFace(),
+		(bool)app().cacheExtractedContentOption(),
+		[this](BoolMenuItem &item)
+		{
+			app().cacheExtractedContentOption() = item.flipBoolValue(*this);
+		}
+	},
+	screenshotFormatItem
+	{
+		{"PNG",         &defaultFace(), setScreenshotFormatDel(), 0},
+		{"PNG (Fast)",  &defaultFace(), setScreenshotFormatDel(), 1},
+		{"PNG (Small)", &defaultFace(), setScreenshotFormatDel(), 2},
+		{"BMP",         &defaultFace(), setScreenshotFormatDel(), 3},
+	},
+	screenshotFormat
+	{
+		"Screenshot Format", &defaultFace(),
+		(MenuItem::Id)app().screenshotFormatOption().val,
+		screenshotFormatItem
+	},
 	performanceMode
 	{
 		"Performance Mode", &defaultFace(),
@@ -143,6 +226,11 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&autosaveTimer);
 	item.emplace_back(&confirmOverwriteState);
 	item.emplace_back(&fastSlowModeSpeed);
+	item.emplace_back(&rewindBufferSize);
+	item.emplace_back(&rewindInterval);
+	item.emplace_back(&runAheadFrames);
+	item.emplace_back(&cacheExtractedContent);
+	item.emplace_back(&screenshotFormat);
 	if(used(performanceMode))
 		item.emplace_back(&performanceMode);
 }
@@ -299,6 +299,15 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, bool customMenu):
 			app().setShouldSkipLateFrames(item.flipBoolValue(*this));
 		}
 	},
+	lowLatencyFramePacing
+	{
+		"Low Latency Frame Pacing", &defaultFace(),
+		app().lowLatencyFramePacing(),
+		[this](BoolMenuItem &item)
+		{
+			app().setLowLatencyFramePacing(item.flipBoolValue(*this));
+		}
+	},
 	frameRate
 	{
 		u"", &defaultFace(),
@@ -566,6 +575,16 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, bool customMenu):
 		(MenuItem::Id)app().videoImageBuffersOption().val,
 		imageBuffersItem
 	},
+	skipUnchangedRows
+	{
+		"Only Upload Changed Video Lines", &defaultFace(),
+		(bool)app().skipUnchangedVideoRowsOption(),
+		[this](BoolMenuItem &item)
+		{
+			app().skipUnchangedVideoRowsOption() = item.flipBoolValue(*this);
+			emuVideo().setSkipUnchangedRows(app().skipUnchangedVideoRowsOption());
+		}
+	},
 	renderPixelFormatItem
 	{
 		{"Auto (Match display format)", &defaultFace(), setRenderPixelFormatDel(), IG::PIXEL_NONE},
@@ -605,6 +624,23 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, bool customMenu):
 			app().setForceMaxScreenFrameRate(item.flipBoolValue(*this));
 		}
 	},
+	showFrameTimeStats
+	{
+		"Show Frame Time Stats", &defaultFace(),
+		app().frameProfiler().isEnabled(),
+		[this](BoolMenuItem &item)
+		{
+			app().frameProfiler().setEnabled(item.flipBoolValue(*this));
+		}
+	},
+	exportFrameTimeTrace
+	{
+		"Export Frame Time Trace", &defaultFace(),
+		[this]
+		{
+			app().exportFrameTimeTrace();
+		}
+	},
 	brightnessItem
 	{
 		{
@@ -765,6 +801,7 @@ void VideoOptionView::loadStockItems()
 	if(used(frameInterval))
 		item.emplace_back(&frameInterval);
 	item.emplace_back(&dropLateFrames);
+	item.emplace_back(&lowLatencyFramePacing);
 	frameRate.setName(makeFrameRateStr(system()));
 	item.emplace_back(&frameRate);
 	if(EmuSystem::hasPALVideoSystem)
@@ -798,6 +835,7 @@ void VideoOptionView::loadStockItems()
 	item.emplace_back(&imgEffectPixelFormat);
 	if(!app().videoImageBuffersOption().isConst)
 		item.emplace_back(&imageBuffers);
+	item.emplace_back(&skipUnchangedRows);
 	if(IG::used(presentationTime) && renderer().supportsPresentationTime())
 		item.emplace_back(&presentationTime);
 	if(IG::used(forceMaxScreenFrameRate) && appContext().androidSDK() >= 30)
@@ -806,6 +844,8 @@ void VideoOptionView::loadStockItems()
 		item.emplace_back(&secondDisplay);
 	if(IG::used(showOnSecondScreen) && !app().showOnSecondScreenOption().isConst)
 		item.emplace_back(&showOnSecondScreen);
+	item.emplace_back(&showFrameTimeStats);
+	item.emplace_back(&exportFrameTimeTrace);
 }
 
 void VideoOptionView::setEmuVideoLayer(EmuVideoLayer &videoLayer_)
@@ -108,6 +108,7 @@ enum
 	guiKeyIdxToggleFastForward,
 	guiKeyIdxTurboModifier,
 	guiKeyIdxExitApp,
+	guiKeyIdxRewind,
 };
 
 }
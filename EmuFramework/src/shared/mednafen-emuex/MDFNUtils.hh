@@ -20,6 +20,11 @@
 #include <mednafen/video/surface.h>
 #include <mednafen/hash/md5.h>
 #include <mednafen/git.h>
+#include <mednafen/Stream.h>
+#include <mednafen/state.h>
+#include <algorithm>
+#include <cstring>
+#include <span>
 #include <string_view>
 
 namespace EmuEx
@@ -74,4 +79,83 @@ inline std::string savePathMDFN(int id1, const char *cd1)
 	return savePathMDFN(EmuEx::gApp(), id1, cd1);
 }
 
+// Stream over a fixed size buffer, used for data-only save states without
+// the copies and allocations of MemoryStream. A null buffer only counts bytes written.
+class SpanStreamMDFN final : public Mednafen::Stream
+{
+public:
+	SpanStreamMDFN(std::span<uint8_t> buff): buff{buff} {}
+
+	uint64 attributes() final
+	{
+		return ATTRIBUTE_READABLE | ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE;
+	}
+
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final
+	{
+		auto bytes = std::min(count, uint64(buff.size() - std::min(pos, buff.size())));
+		if(bytes != count && error_on_eos)
+			throw Mednafen::MDFN_Error(0, "Unexpected EOF while reading state");
+		memcpy(data, buff.data() + pos, bytes);
+		pos += bytes;
+		return bytes;
+	}
+
+	void write(const void *data, uint64 count) final
+	{
+		if(buff.data())
+		{
+			if(pos > buff.size() || count > buff.size() - pos)
+				throw Mednafen::MDFN_Error(0, "State buffer too small");
+			memcpy(buff.data() + pos, data, count);
+		}
+		pos += count;
+		written = std::max(written, pos);
+	}
+
+	void truncate(uint64 length) final {}
+
+	void seek(int64 offset, int whence) final
+	{
+		switch(whence)
+		{
+			case SEEK_SET: pos = offset; break;
+			case SEEK_CUR: pos += offset; break;
+			case SEEK_END: pos = size() + offset; break;
+		}
+	}
+
+	uint64 tell() final { return pos; }
+	uint64 size() final { return buff.data() ? buff.size() : written; }
+	uint64 bytesWritten() const { return written; }
+	void flush() final {}
+	void close() final {}
+
+private:
+	std::span<uint8_t> buff;
+	size_t pos{};
+	size_t written{};
+};
+
+inline size_t stateSizeMDFN()
+{
+	SpanStreamMDFN stream{{}};
+	Mednafen::MDFNSS_SaveSM(&stream, true);
+	return stream.bytesWritten();
+}
+
+inline size_t writeStateMDFN(std::span<uint8_t> buff)
+{
+	SpanStreamMDFN stream{buff};
+	Mednafen::MDFNSS_SaveSM(&stream, true);
+	return stream.bytesWritten();
+}
+
+inline void readStateMDFN(std::span<const uint8_t> buff)
+{
+	// buffer is only read from
+	SpanStreamMDFN stream{{const_cast<uint8_t*>(buff.data()), buff.size()}};
+	Mednafen::MDFNSS_LoadSM(&stream, true);
+}
+
 }
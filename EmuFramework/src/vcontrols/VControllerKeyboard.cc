@@ -136,11 +136,11 @@ bool VControllerKeyboard::keyInput(VController &v, Gfx::Renderer &r, const Input
 		}
 		else if(e.pushed())
 		{
-			v.system().handleInputAction(&v.app(), {currentKey(), Input::Action::PUSHED});
+			v.app().handleSystemInput({currentKey(), Input::Action::PUSHED});
 		}
 		else
 		{
-			v.system().handleInputAction(&v.app(), {currentKey(), Input::Action::RELEASED});
+			v.app().handleSystemInput({currentKey(), Input::Action::RELEASED});
 		}
 		return true;
 	}
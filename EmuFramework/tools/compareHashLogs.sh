@@ -0,0 +1,60 @@
+#!/bin/sh
+
+# Compares hash logs written with --hash-log, or directories of them from --batch runs,
+# reporting the first frame where the video or audio output differs.
+# Usage: compareHashLogs.sh <log or dir A> <log or dir B>
+# Exits with 1 if any output differs or a log is missing frames.
+
+if [ $# -ne 2 ]
+then
+	echo "Usage: $0 <log or dir A> <log or dir B>"
+	exit 2
+fi
+
+compareLogs()
+{
+	awk -v nameA="$1" -v nameB="$2" '
+	/^#/ { next }
+	FNR == NR { video[$1] = $2; audio[$1] = $3; framesA++; next }
+	{
+		framesB++
+		if(!($1 in video)) { missing++; next }
+		if(video[$1] != $2) { if(!videoDiffs++) firstVideo = $1 }
+		if(audio[$1] != $3) { if(!audioDiffs++) firstAudio = $1 }
+		delete video[$1]
+	}
+	END {
+		for(f in video) missing++
+		if(!videoDiffs && !audioDiffs && !missing)
+		{
+			printf "OK %s (%d frames)\n", nameB, framesB
+			exit 0
+		}
+		printf "DIFF %s vs %s:", nameA, nameB
+		if(videoDiffs) printf " %d video frames differ starting at %d,", videoDiffs, firstVideo
+		if(audioDiffs) printf " %d audio frames differ starting at %d,", audioDiffs, firstAudio
+		if(missing) printf " %d frames only in one log,", missing
+		printf " %d/%d frames\n", framesA, framesB
+		exit 1
+	}' "$1" "$2"
+}
+
+if [ -d "$1" ]
+then
+	status=0
+	for logA in "$1"/*.hashes
+	do
+		[ -e "$logA" ] || continue
+		logB="$2/`basename "$logA"`"
+		if [ ! -e "$logB" ]
+		then
+			echo "MISSING $logB"
+			status=1
+			continue
+		fi
+		compareLogs "$logA" "$logB" || status=1
+	done
+	exit $status
+fi
+
+compareLogs "$1" "$2"
@@ -89,6 +89,26 @@ void GbaSystem::loadState(EmuApp &app, IG::CStringView path)
 		return throwFileReadError();
 }
 
+size_t GbaSystem::stateSize()
+{
+	// null buffer only measures the state, which varies with the number of cheats
+	return CPUWriteRawState(gGba, nullptr, 0);
+}
+
+size_t GbaSystem::writeState(std::span<uint8_t> buff)
+{
+	auto size = CPUWriteRawState(gGba, buff.data(), buff.size());
+	if(!size)
+		throwFileWriteError();
+	return size;
+}
+
+void GbaSystem::readState(std::span<const uint8_t> buff)
+{
+	if(!CPUReadRawState(gGba, buff.data(), buff.size()))
+		throwFileReadError();
+}
+
 void GbaSystem::loadBackupMemory(EmuApp &app)
 {
 	CPUReadBatteryFile(appContext(), gGba, app.contentSaveFilePath(".sav").c_str());
@@ -83,6 +83,9 @@ public:
 	std::string_view stateFilenameExt() const { return ".gqs"; }
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
@@ -118,3 +121,5 @@ bool CPUReadBatteryFile(IG::ApplicationContext, GBASys &gba, const char *);
 bool CPUWriteBatteryFile(IG::ApplicationContext, GBASys &gba, const char *);
 bool CPUReadState(IG::ApplicationContext, GBASys &gba, const char *);
 bool CPUWriteState(IG::ApplicationContext, GBASys &gba, const char *);
+size_t CPUWriteRawState(GBASys &gba, uint8_t *data, size_t size);
+bool CPUReadRawState(GBASys &gba, const uint8_t *data, size_t size);
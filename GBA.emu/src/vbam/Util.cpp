@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <algorithm>
 
 #ifndef _WIN32
 #include <sys/stat.h>
@@ -787,6 +788,68 @@ gzFile utilMemGzOpen(char *memory, int available, const char *mode)
         return memgzopen(memory, available, mode);
 }
 
+// uncompressed memory stream, a null data pointer only counts the bytes written
+struct RawMemFile
+{
+        uint8_t *data;
+        size_t size;
+        size_t pos;
+};
+
+static RawMemFile rawMemFile;
+
+static int ZEXPORT rawMemWrite(gzFile file, const voidp buffer, unsigned int len)
+{
+        auto &f = *(RawMemFile *)file;
+        // position keeps advancing on overflow so the caller can detect it from the final size
+        if (f.data && f.pos <= f.size && len <= f.size - f.pos)
+                memcpy(f.data + f.pos, buffer, len);
+        f.pos += len;
+        return len;
+}
+
+static int ZEXPORT rawMemRead(gzFile file, voidp buffer, unsigned int len)
+{
+        auto &f = *(RawMemFile *)file;
+        if (f.pos >= f.size)
+                return 0;
+        len = std::min(size_t(len), f.size - f.pos);
+        memcpy(buffer, f.data + f.pos, len);
+        f.pos += len;
+        return len;
+}
+
+static int ZEXPORT rawMemClose(gzFile file)
+{
+        return 0;
+}
+
+static z_off_t ZEXPORT rawMemSeek(gzFile file, z_off_t offset, int whence)
+{
+        auto &f = *(RawMemFile *)file;
+        size_t base = whence == SEEK_SET ? 0 : whence == SEEK_END ? f.size : f.pos;
+        if (offset < 0 ? size_t(-offset) > base : size_t(offset) > f.size - base)
+                return -1;
+        f.pos = base + offset;
+        return f.pos;
+}
+
+gzFile utilRawMemOpen(uint8_t *data, size_t size)
+{
+        utilGzWriteFunc = rawMemWrite;
+        utilGzReadFunc = rawMemRead;
+        utilGzCloseFunc = rawMemClose;
+        utilGzSeekFunc = rawMemSeek;
+
+        rawMemFile = {data, data ? size : SIZE_MAX, 0};
+        return (gzFile)&rawMemFile;
+}
+
+size_t utilRawMemTell(gzFile file)
+{
+        return ((RawMemFile *)file)->pos;
+}
+
 int utilGzWrite(gzFile file, const voidp buffer, unsigned int len)
 {
         return utilGzWriteFunc(file, buffer, len);
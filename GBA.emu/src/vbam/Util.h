@@ -55,6 +55,8 @@ void utilReadDataMem(const uint8_t *&data, variable_desc *);
 #else
 gzFile utilGzOpen(int fd, const char *mode);
 gzFile utilMemGzOpen(char *memory, int available, const char *mode);
+gzFile utilRawMemOpen(uint8_t *data, size_t size);
+size_t utilRawMemTell(gzFile file);
 int utilGzWrite(gzFile file, const voidp buffer, unsigned int len);
 int utilGzRead(gzFile file, voidp buffer, unsigned int len);
 int utilGzClose(gzFile file);
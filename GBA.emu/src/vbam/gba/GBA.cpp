@@ -1066,6 +1066,33 @@ bool CPUReadState(IG::ApplicationContext ctx, GBASys &gba, const char * file)
 
   return res;
 }
+
+size_t CPUWriteRawState(GBASys &gba, uint8_t *data, size_t size)
+{
+  gzFile gzFile = utilRawMemOpen(data, size);
+
+  bool res = CPUWriteState(gba, gzFile);
+
+  size_t written = utilRawMemTell(gzFile);
+
+  utilGzClose(gzFile);
+
+  if (!res || (data && written > size))
+    return 0;
+
+  return written;
+}
+
+bool CPUReadRawState(GBASys &gba, const uint8_t *data, size_t size)
+{
+  gzFile gzFile = utilRawMemOpen(const_cast<uint8_t*>(data), size);
+
+  bool res = CPUReadState(gba, gzFile);
+
+  utilGzClose(gzFile);
+
+  return res;
+}
 #endif
 
 bool CPUExportEepromFile(const char* fileName)
@@ -164,7 +164,7 @@ public:
 	  */
 	bool loadState(std::string const &filepath);
 
-	bool loadState(std::istream &file);
+	bool loadState(std::istream &file, bool saveSavedata = true);
 
 	/**
 	  * Selects which state slot to save state to or load state from.
@@ -19,9 +19,12 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/format.hh>
 #include <imagine/fs/FS.hh>
+#include <imagine/io/MapIO.hh>
+#include <imagine/io/IOStream.hh>
 #include <resample/resampler.h>
 #include <resample/resamplerinfo.h>
 #include <main/Cheats.hh>
+#include <sstream>
 
 namespace EmuEx
 {
@@ -99,6 +102,36 @@ void GbcSystem::loadState(EmuApp &app, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t GbcSystem::stateSize()
+{
+	if(!saveStateSize)
+	{
+		// state size is fixed once content is loaded, measure it by doing a full save
+		std::ostringstream stream;
+		gbEmu.saveState(nullptr, 0, stream);
+		saveStateSize = stream.tellp();
+	}
+	return saveStateSize;
+}
+
+size_t GbcSystem::writeState(std::span<uint8_t> buff)
+{
+	assert(buff.size() >= saveStateSize);
+	IG::OStream<MapIO> stream{MapIO{buff}};
+	// memory states skip the thumbnail, only state files need it
+	if(!gbEmu.saveState(nullptr, 0, stream))
+		throwFileWriteError();
+	return stream.tellp();
+}
+
+void GbcSystem::readState(std::span<const uint8_t> buff)
+{
+	// buffer is only read from
+	IG::IStream<MapIO> stream{MapIO{{const_cast<uint8_t*>(buff.data()), buff.size()}}};
+	if(!gbEmu.loadState(stream, false))
+		throwFileReadError();
+}
+
 void GbcSystem::loadBackupMemory(EmuApp &)
 {
 	gbEmu.loadSavedata();
@@ -121,6 +154,7 @@ void GbcSystem::closeSystem()
 {
 	cheatList.clear();
 	gameBuiltinPalette = nullptr;
+	saveStateSize = 0;
 	totalFrames = 0;
 	totalSamples = 0;
 }
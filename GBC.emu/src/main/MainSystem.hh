@@ -41,6 +41,7 @@ public:
 	const GBPalette *gameBuiltinPalette{};
 	std::string cheatsDir;
 	uint64_t totalSamples{};
+	size_t saveStateSize{};
 	uint32_t totalFrames{};
 	uint8_t activeResampler = 1;
 	bool useBgrOrder{};
@@ -78,6 +79,9 @@ public:
 	std::string_view stateFilenameExt() const { return ".sta"; }
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
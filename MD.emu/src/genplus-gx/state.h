@@ -42,5 +42,8 @@
 /* Function prototypes */
 void state_load(const unsigned char *buffer);
 int state_save(unsigned char *buffer);
+/* uncompressed state data, STATE_SIZE bytes max */
+void state_load_raw(unsigned char *state, unsigned long size);
+int state_save_raw(unsigned char *state);
 
 #endif
@@ -162,6 +162,20 @@ void MdSystem::loadState(EmuApp &app, IG::CStringView path)
 	state_load(FileUtils::bufferFromUri(app.appContext(), path).data());
 }
 
+size_t MdSystem::stateSize() { return STATE_SIZE; }
+
+size_t MdSystem::writeState(std::span<uint8_t> buff)
+{
+	assert(buff.size() >= STATE_SIZE);
+	return state_save_raw(buff.data());
+}
+
+void MdSystem::readState(std::span<const uint8_t> buff)
+{
+	// context loaders take non-const pointers but only read from the buffer
+	state_load_raw(const_cast<uint8_t*>(buff.data()), buff.size());
+}
+
 static bool sramHasContent(std::span<uint8> sram)
 {
 	for(auto v : sram)
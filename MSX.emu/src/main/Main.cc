@@ -594,6 +594,33 @@ void MsxSystem::loadState(EmuApp &app, IG::CStringView path)
 	return loadBlueMSXState(app, path);
 }
 
+// memory states only contain the machine state since the board and media don't change
+size_t MsxSystem::stateSize()
+{
+	return writeState({});
+}
+
+size_t MsxSystem::writeState(std::span<uint8_t> buff)
+{
+	zipStartMemWrite(buff.data(), buff.size());
+	saveStateCreateForWrite(memStateName);
+	boardInfo.saveState();
+	saveStateDestroy();
+	auto size = zipEndMemWrite();
+	if(!size)
+		throwFileWriteError();
+	return size;
+}
+
+void MsxSystem::readState(std::span<const uint8_t> buff)
+{
+	zipStartMemRead(buff.data(), buff.size());
+	saveStateCreateForRead(memStateName);
+	boardInfo.loadState();
+	saveStateDestroy();
+	zipEndMemRead();
+}
+
 void MsxSystem::closeSystem()
 {
 	destroyMachine();
@@ -19,6 +19,12 @@ extern Machine *machine;
 
 bool zipStartWrite(const char *fileName);
 void zipEndWrite();
+// zip name that redirects state files to the buffer given to zipStartMem*()
+constexpr const char *memStateName = "memstate";
+void zipStartMemWrite(void *buff, size_t size);
+size_t zipEndMemWrite();
+void zipStartMemRead(const void *buff, size_t size);
+void zipEndMemRead();
 IG::PixmapView frameBufferPixmap();
 HdType boardGetHdType(int hdIndex);
 
@@ -83,6 +89,9 @@ public:
 	std::string_view stateFilenameExt() const { return ".sta"; }
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
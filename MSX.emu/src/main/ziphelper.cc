@@ -23,7 +23,10 @@
 #include <imagine/util/ScopeGuard.hh>
 #include "ziphelper.h"
 #include "MainSystem.hh"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <span>
 
 namespace EmuEx
 {
@@ -36,8 +39,107 @@ static struct archive *writeArch{};
 static FS::ArchiveIterator cachedZipIt{};
 static FS::PathString cachedZipName{};
 
+// Flat buffer used in place of a zip archive for the memStateName zip name,
+// each file is stored as its name size, name, data size, and data.
+// A null buffer only counts the bytes written.
+static struct MemZip
+{
+	std::span<uint8_t> buff{};
+	size_t size{};
+	bool overflow{};
+} memZip;
+
+static bool isMemZip(const char *zipName)
+{
+	return strcmp(zipName, memStateName) == 0;
+}
+
+static void memZipWrite(const void *data, size_t size)
+{
+	if(memZip.buff.data())
+	{
+		if(size > memZip.buff.size() - std::min(memZip.size, memZip.buff.size()))
+			memZip.overflow = true;
+		else
+			memcpy(memZip.buff.data() + memZip.size, data, size);
+	}
+	memZip.size += size;
+}
+
+static bool memZipRead(size_t &pos, void *data, size_t size)
+{
+	if(size > memZip.buff.size() - pos)
+		return false;
+	memcpy(data, memZip.buff.data() + pos, size);
+	pos += size;
+	return true;
+}
+
+void zipStartMemWrite(void *buff, size_t size)
+{
+	memZip = {{(uint8_t*)buff, size}};
+}
+
+size_t zipEndMemWrite()
+{
+	size_t size = memZip.overflow ? 0 : memZip.size;
+	memZip = {};
+	return size;
+}
+
+void zipStartMemRead(const void *buff, size_t size)
+{
+	memZip = {{(uint8_t*)buff, size}, size}; // buffer is only read from
+}
+
+void zipEndMemRead()
+{
+	memZip = {};
+}
+
+static void *memZipLoadFile(const char* fileName, int* size)
+{
+	size_t pos = 0;
+	auto fileNameSize = strlen(fileName);
+	while(pos < memZip.size)
+	{
+		uint32_t nameSize, dataSize;
+		if(!memZipRead(pos, &nameSize, sizeof(nameSize)) || nameSize > memZip.size - pos)
+			break;
+		bool nameMatches = nameSize == fileNameSize && !memcmp(memZip.buff.data() + pos, fileName, nameSize);
+		pos += nameSize;
+		if(!memZipRead(pos, &dataSize, sizeof(dataSize)) || dataSize > memZip.size - pos)
+			break;
+		if(nameMatches)
+		{
+			void *buff = malloc(dataSize);
+			memcpy(buff, memZip.buff.data() + pos, dataSize);
+			*size = dataSize;
+			return buff;
+		}
+		pos += dataSize;
+	}
+	logErr("file %s not in memory state", fileName);
+	return nullptr;
+}
+
+static int memZipSaveFile(const char* fileName, const void* buffer, int size)
+{
+	uint32_t nameSize = strlen(fileName);
+	uint32_t dataSize = size;
+	memZipWrite(&nameSize, sizeof(nameSize));
+	memZipWrite(fileName, nameSize);
+	memZipWrite(&dataSize, sizeof(dataSize));
+	memZipWrite(buffer, dataSize);
+	return !memZip.overflow;
+}
+
 void zipCacheReadOnlyZip(const char* zipName)
 {
+	if(zipName && isMemZip(zipName))
+	{
+		return;
+	}
 	if(zipName && strlen(zipName))
 	{
 		logMsg("setting cached read zip archive:%s", zipName);
@@ -79,6 +181,10 @@ static void *loadFromArchiveIt(FS::ArchiveIterator &it, const char* zipName, con
 
 void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 {
+	if(isMemZip(zipName))
+	{
+		return memZipLoadFile(fileName, size);
+	}
 	try
 	{
 		if(cachedZipIt.hasEntry() && cachedZipName == zipName)
@@ -118,6 +224,10 @@ bool zipStartWrite(const char *fileName)
 
 int zipSaveFile(const char* zipName, const char* fileName, int append, const void* buffer, int size)
 {
+	if(isMemZip(zipName))
+	{
+		return memZipSaveFile(fileName, buffer, size);
+	}
 	assert(writeArch);
 	auto entry = archive_entry_new();
 	auto freeEntry = IG::scopeGuard([&](){ archive_entry_free(entry); });
@@ -491,7 +491,31 @@ static gzFile open_state(void *contextPtr, const char *st_name, int mode) {
 	return open_stateWithName(st_name, mode);
 }*/
 
+/* memory buffer used in place of the gzFile by the mem state functions,
+ * a NULL data pointer only counts the bytes written */
+static struct {
+	Uint8 *data;
+	size_t size;
+	size_t pos;
+	bool active;
+	bool overflow; /* set when a read or write ran past size */
+} mem_state;
+
 int mkstate_data(gzFile gzf,void *data,int size,int mode) {
+	if (mem_state.active) {
+		if (mem_state.data) {
+			if (mem_state.pos > mem_state.size || size > mem_state.size - mem_state.pos) {
+				mem_state.overflow = true;
+				return 0;
+			}
+			if (mode==STREAD)
+				memcpy(data, mem_state.data + mem_state.pos, size);
+			else
+				memcpy(mem_state.data + mem_state.pos, data, size);
+		}
+		mem_state.pos += size;
+		return size;
+	}
 	if (mode==STREAD)
 		return gzread(gzf,data,size);
 	return gzwrite(gzf,data,size);
@@ -553,8 +577,7 @@ int save_stateWithName(void *contextPtr, const char *name) {
 	return true;
 }
 
-int load_stateWithName(void *contextPtr, const char *name) {
-	gzFile gzf;
+static void load_state_data(gzFile gzf) {
 	/* Save pointers */
 	Uint8 *ng_lo = memory.ng_lo;
 	Uint8 *fix_game_usage=memory.fix_game_usage;
@@ -562,9 +585,6 @@ int load_stateWithName(void *contextPtr, const char *name) {
 	int *bksw_offset=memory.bksw_offset;
 //	GAME_ROMS r;
 //	memcpy(&r,&memory.rom,sizeof(GAME_ROMS));
-	
-	if ((gzf = open_state(contextPtr, name, STREAD))==NULL)
-		return false;
 
 	//gzread(gzf,state_img_tmp->pixels,304*224*2);
 
@@ -600,9 +620,50 @@ int load_stateWithName(void *contextPtr, const char *name) {
 		fix_usage = memory.fix_board_usage;
 	}
 
+}
+
+int load_stateWithName(void *contextPtr, const char *name) {
+	gzFile gzf;
+
+	if ((gzf = open_state(contextPtr, name, STREAD))==NULL)
+		return false;
+
+	load_state_data(gzf);
+
 	gzclose(gzf);
 	return true;
 }
+
+size_t save_stateToMem(void *data, size_t size) {
+	size_t written;
+
+	mem_state.data = data;
+	mem_state.size = size;
+	mem_state.pos = 0;
+	mem_state.active = true;
+	mem_state.overflow = false;
+
+	neogeo_mkstate(NULL,STWRITE);
+
+	mem_state.active = false;
+	written = mem_state.pos;
+	if (mem_state.overflow)
+		return 0;
+	return written;
+}
+
+int load_stateFromMem(const void *data, size_t size) {
+	mem_state.data = (Uint8*)data;
+	mem_state.size = size;
+	mem_state.pos = 0;
+	mem_state.active = true;
+	mem_state.overflow = false;
+
+	load_state_data(NULL);
+
+	mem_state.active = false;
+	return !mem_state.overflow;
+}
 #endif
 
 #if 0
@@ -92,6 +92,8 @@ void set_post_load_function(ST_MODULE_TYPE module,void (*func)(void));
 //SDL_Surface *load_state_img(char *game,int slot);
 int save_stateWithName(void *contextPtr, const char *name);
 int load_stateWithName(void *contextPtr, const char *name);
+size_t save_stateToMem(void *data, size_t size);
+int load_stateFromMem(const void *data, size_t size);
 Uint32 how_many_slot(char *game);
 int mkstate_data(gzFile gzf,void *data,int size,int mode);
 gzFile gzopenHelper(void *contextPtr, const char *filename, const char *mode);
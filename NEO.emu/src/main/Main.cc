@@ -34,6 +34,7 @@ extern "C"
 	#include <gngeo/screen.h>
 	#include <gngeo/menu.h>
 	#include <gngeo/resfile.h>
+	#include <gngeo/state.h>
 
 	CONFIG conf{};
 	GN_Rect visible_area;
@@ -162,6 +163,25 @@ void NeoSystem::loadState(EmuApp &app, IG::CStringView path)
 		return EmuSystem::throwFileReadError();
 }
 
+size_t NeoSystem::stateSize()
+{
+	return save_stateToMem(nullptr, 0);
+}
+
+size_t NeoSystem::writeState(std::span<uint8_t> buff)
+{
+	auto size = save_stateToMem(buff.data(), buff.size());
+	if(!size)
+		throwFileWriteError();
+	return size;
+}
+
+void NeoSystem::readState(std::span<const uint8_t> buff)
+{
+	if(!load_stateFromMem(buff.data(), buff.size()))
+		throwFileReadError();
+}
+
 static auto nvramPath(EmuApp &app)
 {
 	return app.contentSaveFilePath(".nv");
@@ -17,7 +17,7 @@
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/io/IO.hh>
 #include <imagine/io/FileIO.hh>
-#include <imagine/fs/ArchiveFS.hh>
+#include <imagine/fs/ArchiveIndex.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/logger/logger.h>
@@ -32,31 +32,38 @@ extern "C"
 
 using namespace IG;
 
-struct PKZIP : public FS::ArchiveIterator {};
+// ROM sets are opened by CRC in an arbitrary order, index the archive once
+// so opening entries in archive order doesn't rewind for every file. ROM data
+// is read straight into its region, so entries are streamed instead of cached.
+struct PKZIP : public FS::ArchiveIndex
+{
+	using ArchiveIndex::ArchiveIndex;
+};
 
 struct ZFILE
 {
-	ArchiveIO io;
-	FS::ArchiveIterator *arch;
+	IO io;
+	PKZIP *arch;
 };
 
 ZFILE *gn_unzip_fopen(PKZIP *archPtr, const char *filename, uint32_t fileCRC)
 {
 	auto &arch = *archPtr;
-	arch.rewind();
-	for(auto &entry : arch)
+	int loadByName = fileCRC == (uint32_t)-1 || !gn_strictROMChecking();
+	for(auto &entry : arch.entries())
 	{
-		if(entry.type() == FS::file_type::directory)
+		if(entry.type == FS::file_type::directory)
 		{
 			continue;
 		}
-		auto crc = entry.crc32();
-		//logMsg("archive file entry:%s crc32:0x%X", name, crc);
-		int loadByName = fileCRC == (uint32_t)-1 || !gn_strictROMChecking();
-		if((loadByName && entry.name() == filename) || crc == fileCRC)
+		//logMsg("archive file entry:%s crc32:0x%X", entry.name.data(), entry.crc32);
+		if((loadByName && entry.name == filename) || entry.crc32 == fileCRC)
 		{
 			//logMsg("opened archive entry file:%s crc32:0x%X", name, crc);
-			return new ZFILE{entry.moveIO(), archPtr};
+			auto io = arch.open(entry);
+			if(!io)
+				return nullptr;
+			return new ZFILE{std::move(io), archPtr};
 		}
 	}
 	logMsg("file:%s crc32:0x%X not found in archive", filename, fileCRC);
@@ -66,7 +73,7 @@ ZFILE *gn_unzip_fopen(PKZIP *archPtr, const char *filename, uint32_t fileCRC)
 void gn_unzip_fclose(ZFILE *z)
 {
 	//logMsg("done with archive entry");
-	*z->arch = z->io.releaseArchive();
+	z->arch->close(std::move(z->io));
 	delete z;
 }
 
@@ -81,8 +88,8 @@ PKZIP *gn_open_zip(void *contextPtr, const char *path)
 	auto &ctx = *((IG::ApplicationContext*)contextPtr);
 	try
 	{
-		auto arch = std::make_unique<FS::ArchiveIterator>(ctx.openFileUri(path));
-		return static_cast<PKZIP*>(arch.release());
+		auto arch = std::make_unique<PKZIP>(ctx.openFileUri(path), 0);
+		return arch.release();
 	}
 	catch(...)
 	{
@@ -29,6 +29,15 @@ EmuFileIO::EmuFileIO(IG::IO &srcIO):
 	}
 }
 
+EmuFileIO::EmuFileIO(IG::MapIO srcIO):
+	io{std::move(srcIO)}
+{
+	if(!io) [[unlikely]]
+	{
+		failbit = true;
+	}
+}
+
 void EmuFileIO::truncate(s32 length) {}
 
 int EmuFileIO::fgetc()
@@ -36,6 +45,13 @@ int EmuFileIO::fgetc()
 	return IG::fgetc(io);
 }
 
+int EmuFileIO::fputc(int c)
+{
+	uint8_t byte = c;
+	fwrite(&byte, 1);
+	return failbit ? EOF : c;
+}
+
 size_t EmuFileIO::_fread(const void *ptr, size_t bytes)
 {
 	ssize_t ret = io.read((void*)ptr, bytes);
@@ -44,6 +60,12 @@ size_t EmuFileIO::_fread(const void *ptr, size_t bytes)
 	return ret;
 }
 
+void EmuFileIO::fwrite(const void *ptr, size_t bytes)
+{
+	if(io.write(ptr, bytes) != (ssize_t)bytes)
+		failbit = true;
+}
+
 int EmuFileIO::fseek(int offset, int origin)
 {
 	return IG::fseek(io, offset, origin);
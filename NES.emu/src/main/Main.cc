@@ -30,6 +30,7 @@
 #include <fceu/video.h>
 #include <fceu/sound.h>
 #include <fceu/x6502.h>
+#include <zlib.h>
 
 void ApplyDeemphasisComplete(pal* pal512);
 void FCEU_setDefaultPalettePtr(pal *ptr);
@@ -126,6 +127,30 @@ void NesSystem::loadState(EmuApp &app, IG::CStringView path)
 		EmuSystem::throwFileReadError();
 }
 
+size_t NesSystem::stateSize()
+{
+	EMUFILE_MEMORY stateMem;
+	FCEUSS_SaveMS(&stateMem, Z_NO_COMPRESSION);
+	return stateMem.size();
+}
+
+size_t NesSystem::writeState(std::span<uint8_t> buff)
+{
+	EmuFileIO stateIO{MapIO{buff}};
+	if(!FCEUSS_SaveMS(&stateIO, Z_NO_COMPRESSION) || stateIO.fail())
+		throwFileWriteError();
+	return stateIO.ftell();
+}
+
+void NesSystem::readState(std::span<const uint8_t> buff)
+{
+	// buffer is only read from
+	EmuFileIO stateIO{MapIO{{const_cast<uint8_t*>(buff.data()), buff.size()}}};
+	if(!FCEUSS_LoadFP(&stateIO, SSLOADPARAM_NOBACKUP))
+		throwFileReadError();
+	newppu_hacky_emergency_reset();
+}
+
 void NesSystem::loadBackupMemory(EmuApp &app)
 {
 	if(!hasContent())
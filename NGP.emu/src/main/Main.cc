@@ -75,6 +75,10 @@ void NgpSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t NgpSystem::stateSize() { return stateSizeMDFN(); }
+size_t NgpSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+void NgpSystem::readState(std::span<const uint8_t> buff) { readStateMDFN(buff); }
+
 static FS::PathString saveFilename(const EmuApp &app)
 {
 	return app.contentSaveFilePath(".ngf");
@@ -268,6 +268,10 @@ void PceSystem::loadState(EmuApp &, CStringView path)
 		throwFileReadError();
 }
 
+size_t PceSystem::stateSize() { return stateSizeMDFN(); }
+size_t PceSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+void PceSystem::readState(std::span<const uint8_t> buff) { readStateMDFN(buff); }
+
 double PceSystem::videoAspectRatioScale() const
 {
 	double baseLines = 224.;
@@ -25,7 +25,8 @@ SRC += main/Main.cc \
 main/input.cc \
 main/options.cc \
 main/EmuMenuViews.cc \
-main/EmuControls.cc
+main/EmuControls.cc \
+main/threads.cc
 
 CPPFLAGS += -I$(projectPath)/src \
 -DHAVE_SYS_TIME_H=1 \
@@ -42,9 +43,21 @@ ifeq ($(ARCH), arm)
   yabause/sh2_dynarec/sh2_dynarec.c
  endif
 else ifeq ($(ARCH), x86_64)
- # TODO: x86_64 dynarec has 64/32-bit pointer conversion issues
- #CPPFLAGS += -DCPU_X64=1 -DUSE_DYNAREC=1 -DSH2_DYNAREC=1
- #SRC += yabause/sh2_dynarec/linkage_x64.s yabause/sh2_dynarec/sh2_dynarec.c
+ ifeq ($(ENV), linux)
+  # generated code addresses globals with 32-bit displacements,
+  # so the executable must be linked below 2GB,
+  # the SH2 dynarec is selectable but the interpreter stays the default
+  CPPFLAGS += -DCPU_X64=1 \
+  -DUSE_DYNAREC=1 \
+  -DSH2_DYNAREC=1 \
+  -DQ68_USE_JIT=1
+  CFLAGS_CODEGEN += -fno-pie
+  LDFLAGS += -no-pie
+  SRC += yabause/sh2_dynarec/linkage_x64.s \
+  yabause/sh2_dynarec/sh2_dynarec.c \
+  yabause/q68/q68-jit.c \
+  yabause/q68/q68-jit-x86.S
+ endif
 else ifeq ($(ARCH), x86)
  CPPFLAGS += -DCPU_X86=1 \
  -DUSE_DYNAREC=1 \
@@ -93,7 +106,6 @@ SRC += yabause/q68/q68.c \
 yabause/q68/q68-core.c \
 yabause/m68kq68.c
 CPPFLAGS += -DHAVE_Q68=1
-# TODO: -DQ68_USE_JIT=1
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 
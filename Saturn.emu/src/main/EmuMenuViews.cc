@@ -21,6 +21,11 @@
 #include <imagine/fs/FS.hh>
 #include <imagine/util/format.hh>
 
+extern "C"
+{
+	#include <yabause/scsp.h>
+}
+
 namespace EmuEx
 {
 
@@ -28,6 +33,7 @@ template <class T>
 using MainAppHelper = EmuAppHelper<T, MainApp>;
 
 static constexpr unsigned MAX_SH2_CORES = 4;
+static constexpr unsigned MAX_M68K_CORES = 4;
 
 class CustomSystemOptionView : public SystemOptionView
 {
@@ -70,6 +76,35 @@ class CustomSystemOptionView : public SystemOptionView
 		sh2CoreItem
 	};
 
+	BoolMenuItem soundThread
+	{
+		"Threaded Sound", &defaultFace(),
+		(bool)optionSoundThread,
+		[this](BoolMenuItem &item)
+		{
+			optionSoundThread = item.flipBoolValue(*this);
+			if(system().hasContent())
+				ScspSetThreaded(useSoundThread());
+		}
+	};
+
+	StaticArrayList<TextMenuItem, MAX_M68K_CORES> m68kCoreItem;
+
+	MultiChoiceMenuItem m68kCore
+	{
+		"68K", &defaultFace(),
+		[]() -> int
+		{
+			for(auto i : iotaCount(std::min(M68KCores, MAX_M68K_CORES)))
+			{
+				if(M68KCoreList[i]->id == yinit.m68kcoretype)
+					return i;
+			}
+			return 0;
+		}(),
+		m68kCoreItem
+	};
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
@@ -88,6 +123,21 @@ public:
 			}
 			item.emplace_back(&sh2Core);
 		}
+		if(M68KCores > 1)
+		{
+			for(auto i : iotaCount(std::min(M68KCores, MAX_M68K_CORES)))
+			{
+				int id = M68KCoreList[i]->id;
+				m68kCoreItem.emplace_back(M68KCoreList[i]->Name, &defaultFace(),
+					[id]()
+					{
+						yinit.m68kcoretype = id;
+						optionM68KCore = id;
+					});
+			}
+			item.emplace_back(&m68kCore);
+		}
+		item.emplace_back(&soundThread);
 		item.emplace_back(&bios);
 	}
 };
@@ -19,6 +19,10 @@
 #include <imagine/fs/FS.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/util/hash.hh>
+#include <imagine/io/MapIO.hh>
+#include <cstdlib>
+#include <thread>
 
 extern "C"
 {
@@ -32,17 +36,30 @@ extern "C"
 	#include <yabause/cdbase.h>
 	#include <yabause/cs0.h>
 	#include <yabause/cs2.h>
+	#include <yabause/memory.h>
+	#include <yabause/vdp1.h>
+	#include <yabause/vdp2.h>
 }
 
 // from sh2_dynarec.c
 #define SH2CORE_DYNAREC 2
+// the x86_64 dynarec is opt-in until SATURN_SH2_LOCKSTEP runs on real content come back clean
 extern const int defaultSH2CoreID =
-#ifdef SH2_DYNAREC
+#if defined SH2_DYNAREC && !defined CPU_X64
 SH2CORE_DYNAREC;
 #else
 SH2CORE_INTERPRETER;
 #endif
 
+extern const int defaultM68KCoreID =
+#if defined(Q68_USE_JIT)
+M68KCORE_Q68JIT;
+#elif defined(HAVE_Q68)
+M68KCORE_Q68;
+#else
+M68KCORE_C68K;
+#endif
+
 PerInterface_struct *PERCoreList[] =
 {
 	&PERDummy,
@@ -118,22 +135,6 @@ VideoInterface_struct *VIDCoreList[] =
 	nullptr
 };
 
-#if !defined HAVE_Q68 && !defined HAVE_C68K
-#warning No 68K cores compiled in
-#endif
-
-M68K_struct *M68KCoreList[] =
-{
-	//&M68KDummy,
-	#ifdef HAVE_C68K
-	&M68KC68K,
-	#endif
-	#ifdef HAVE_Q68
-	&M68KQ68,
-	#endif
-	nullptr
-};
-
 static void SNDImagineUpdateAudioNull(u32 *leftchanbuffer, u32 *rightchanbuffer, u32 frames);
 static void SNDImagineUpdateAudio(u32 *leftchanbuffer, u32 *rightchanbuffer, u32 frames);
 
@@ -157,6 +158,12 @@ bool hasBIOSExtension(std::string_view name)
 	return IG::endsWithAnyCaseless(name, ".bin");
 }
 
+bool useSoundThread()
+{
+	// SCSP output is generated a frame behind on the thread, only worth it with a core to spare
+	return optionSoundThread && std::thread::hardware_concurrency() > 1;
+}
+
 static FS::PathString bupPath{};
 static char mpegPath[] = "";
 static char cartPath[] = "";
@@ -169,11 +176,7 @@ yabauseinit_struct yinit
 	defaultSH2CoreID,
 	VIDCORE_SOFT,
 	SNDCORE_IMAGINE,
-	#if defined(HAVE_Q68)
-	M68KCORE_Q68,
-	#else
-	M68KCORE_C68K,
-	#endif
+	defaultM68KCoreID,
 	CDCORE_ISO,
 	CART_NONE,
 	REGION_AUTODETECT,
@@ -267,6 +270,44 @@ void SaturnSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t SaturnSystem::stateSize()
+{
+	if(!saveStateSize)
+	{
+		// state size is fixed once content is loaded, measure it with a save to a buffer large enough for any state
+		constexpr size_t maxStateSize = 16 * 1024 * 1024;
+		IG::ByteBuffer buff{maxStateSize};
+		saveStateSize = writeState(buff.span());
+		logMsg("state size:%zu", saveStateSize);
+	}
+	return saveStateSize;
+}
+
+size_t SaturnSystem::writeState(std::span<uint8_t> buff)
+{
+	auto f = MapIO{buff}.toFileStream("wb");
+	if(!f)
+		throwFileWriteError();
+	auto size = YabSaveStateStream(f, 1);
+	bool hasError = fflush(f) || ferror(f);
+	fclose(f);
+	if(size < 0 || hasError)
+		throwFileWriteError();
+	return size;
+}
+
+void SaturnSystem::readState(std::span<const uint8_t> buff)
+{
+	// buffer is only read from
+	auto f = MapIO{{const_cast<uint8_t*>(buff.data()), buff.size()}}.toFileStream("rb");
+	if(!f)
+		throwFileReadError();
+	auto ret = YabLoadStateStream(f, nullptr);
+	fclose(f);
+	if(ret != 0)
+		throwFileReadError();
+}
+
 void SaturnSystem::onFlushBackupMemory(EmuApp &, BackupMemoryDirtyFlags)
 {
 	if(hasContent())
@@ -285,11 +326,25 @@ void SaturnSystem::closeSystem()
 		YabauseDeInit();
 		yabauseIsInit = 0;
 	}
+	saveStateSize = 0;
+	#ifdef SH2_DYNAREC
+	sh2LockstepCompare = false;
+	lockstepState = {};
+	#endif
 }
 
 void SaturnSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate)
 {
 	bupPath = contentSavePath("bkram.bin");
+	#ifdef SH2_DYNAREC
+	if(yinit.sh2coretype == SH2CORE_DYNAREC && SH2Dynarec.Init() != 0)
+	{
+		logWarn("SH2 dynarec can't run in this process, using interpreter");
+		yinit.sh2coretype = SH2CORE_INTERPRETER;
+	}
+	#endif
+	// draw VDP2 layers on worker threads when there are enough cores to spare
+	yinit.usethreads = std::thread::hardware_concurrency() >= 4;
 	if(YabauseInit(&yinit) != 0)
 	{
 		logErr("YabauseInit failed");
@@ -302,6 +357,17 @@ void SaturnSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelega
 	pad[0] = PerPadAdd(&PORTDATA1);
 	pad[1] = PerPadAdd(&PORTDATA2);
 	ScspSetFrameAccurate(1);
+	ScspSetThreaded(useSoundThread());
+	#ifdef SH2_DYNAREC
+	sh2LockstepCompare = SH2Core == &SH2Dynarec && getenv("SATURN_SH2_LOCKSTEP");
+	if(sh2LockstepCompare)
+	{
+		logMsg("comparing SH2 dynarec against interpreter every frame");
+		SH2Interpreter.Init();
+		lockstepState = IG::ByteBuffer{stateSize()};
+		lockstepFrame = 0;
+	}
+	#endif
 }
 
 void SaturnSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
@@ -311,14 +377,106 @@ void SaturnSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
 
 void SaturnSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
+	#ifdef SH2_DYNAREC
+	if(sh2LockstepCompare) [[unlikely]]
+		runSH2LockstepDynarecPass();
+	#endif
 	emuSysTask = taskCtx;
 	emuVideo = video;
 	emuAudio = audio;
 	SNDImagine.UpdateAudio = audio ? SNDImagineUpdateAudio : SNDImagineUpdateAudioNull;
 	YabauseEmulate();
 	emuAudio = {};
+	#ifdef SH2_DYNAREC
+	if(sh2LockstepCompare) [[unlikely]]
+		finishSH2LockstepFrame();
+	#endif
+}
+
+#ifdef SH2_DYNAREC
+SH2LockstepSnapshot SH2LockstepSnapshot::make()
+{
+	SH2LockstepSnapshot snap;
+	SH2GetRegisters(MSH2, &snap.msh2);
+	SH2GetRegisters(SSH2, &snap.ssh2);
+	snap.highWramHash = IG::hashBytes({HighWram, 0x100000});
+	snap.lowWramHash = IG::hashBytes({LowWram, 0x100000});
+	snap.vdp1RamHash = IG::hashBytes({Vdp1Ram, 0x80000});
+	snap.vdp2RamHash = IG::hashBytes({Vdp2Ram, 0x80000});
+	return snap;
+}
+
+static bool logSH2RegDifferences(const char *cpuName, const sh2regs_struct &a, const sh2regs_struct &b, uint64_t frame)
+{
+	bool matches = true;
+	auto compare = [&](const char *regName, u32 dynarecVal, u32 interpreterVal)
+	{
+		if(dynarecVal == interpreterVal)
+			return;
+		logWarn("frame %llu %s %s dynarec:0x%08X interpreter:0x%08X",
+			(unsigned long long)frame, cpuName, regName, (unsigned)dynarecVal, (unsigned)interpreterVal);
+		matches = false;
+	};
+	static constexpr const char *gprNames[]{"R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7",
+		"R8", "R9", "R10", "R11", "R12", "R13", "R14", "R15"};
+	for(auto i : IG::iotaCount(16))
+	{
+		compare(gprNames[i], a.R[i], b.R[i]);
+	}
+	compare("SR", a.SR.all, b.SR.all);
+	compare("GBR", a.GBR, b.GBR);
+	compare("VBR", a.VBR, b.VBR);
+	compare("MACH", a.MACH, b.MACH);
+	compare("MACL", a.MACL, b.MACL);
+	compare("PR", a.PR, b.PR);
+	compare("PC", a.PC, b.PC);
+	return matches;
+}
+
+bool SH2LockstepSnapshot::logDifferences(const SH2LockstepSnapshot &interpreter, uint64_t frame) const
+{
+	bool matches = logSH2RegDifferences("MSH2", msh2, interpreter.msh2, frame);
+	matches &= logSH2RegDifferences("SSH2", ssh2, interpreter.ssh2, frame);
+	auto compare = [&](const char *name, uint64_t dynarecHash, uint64_t interpreterHash)
+	{
+		if(dynarecHash == interpreterHash)
+			return;
+		logWarn("frame %llu %s contents differ", (unsigned long long)frame, name);
+		matches = false;
+	};
+	compare("high work RAM", highWramHash, interpreter.highWramHash);
+	compare("low work RAM", lowWramHash, interpreter.lowWramHash);
+	compare("VDP1 RAM", vdp1RamHash, interpreter.vdp1RamHash);
+	compare("VDP2 RAM", vdp2RamHash, interpreter.vdp2RamHash);
+	return matches;
 }
 
+void SaturnSystem::runSH2LockstepDynarecPass()
+{
+	// run the frame with no output on the dynarec and record the result
+	writeState(lockstepState.span());
+	emuVideo = {};
+	SNDImagine.UpdateAudio = SNDImagineUpdateAudioNull;
+	YabauseEmulate();
+	lockstepDynarecResult = SH2LockstepSnapshot::make();
+	// rerun the same frame on the interpreter, loading the state routes the SH2 registers to it
+	SH2Core = &SH2Interpreter;
+	readState(lockstepState.span());
+}
+
+void SaturnSystem::finishSH2LockstepFrame()
+{
+	if(!lockstepDynarecResult.logDifferences(SH2LockstepSnapshot::make(), lockstepFrame))
+		logWarn("frame %llu: SH2 dynarec diverged from interpreter", (unsigned long long)lockstepFrame);
+	lockstepFrame++;
+	// continue from the interpreter's result so one divergence isn't reported on every later frame,
+	// loading the state also invalidates blocks compiled from memory the interpreter changed
+	writeState(lockstepState.span());
+	SH2Core = &SH2Dynarec;
+	readState(lockstepState.span());
+}
+#endif
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
@@ -350,4 +508,4 @@ static void SNDImagineUpdateAudio(u32 *leftchanbuffer, u32 *rightchanbuffer, u32
 CLINK void DisplayMessage(const char* str) {}
 CLINK int OSDInit(int coreid) { return 0; }
 CLINK void OSDPushMessage(int msgtype, int ttl, const char * message, ...) {}
-CLINK void OSDDisplayMessages(void) {}
+CLINK int OSDDisplayMessages(pixel_t *, int, int) { return 0; }
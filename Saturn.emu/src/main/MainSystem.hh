@@ -2,11 +2,13 @@
 
 #include <emuframework/Option.hh>
 #include <emuframework/EmuSystem.hh>
+#include <imagine/util/memory/Buffer.hh>
 
 extern "C"
 {
 	#include <yabause/yabause.h>
 	#include <yabause/sh2core.h>
+	#include <yabause/m68kcore.h>
 	#include <yabause/peripheral.h>
 }
 
@@ -17,19 +19,45 @@ static const unsigned gamepadKeys = 23;
 
 extern const int defaultSH2CoreID;
 extern SH2Interface_struct *SH2CoreList[];
+extern const int defaultM68KCoreID;
+extern M68K_struct *M68KCoreList[];
 
 namespace EmuEx
 {
 
+#ifdef SH2_DYNAREC
+struct SH2LockstepSnapshot
+{
+	sh2regs_struct msh2{}, ssh2{};
+	uint64_t highWramHash{}, lowWramHash{}, vdp1RamHash{}, vdp2RamHash{};
+
+	static SH2LockstepSnapshot make();
+	bool logDifferences(const SH2LockstepSnapshot &interpreter, uint64_t frame) const;
+};
+#endif
+
 extern Byte1Option optionSH2Core;
 extern FS::PathString biosPath;
 extern unsigned SH2Cores;
+extern Byte1Option optionM68KCore;
+extern unsigned M68KCores;
+extern Byte1Option optionSoundThread;
 extern yabauseinit_struct yinit;
 extern PerPad_struct *pad[2];
 
 class SaturnSystem final: public EmuSystem
 {
 public:
+	size_t saveStateSize{};
+	#ifdef SH2_DYNAREC
+	// runs every frame on the dynarec then again from the same state on the interpreter,
+	// logging any differences, enabled with SATURN_SH2_LOCKSTEP in the environment
+	bool sh2LockstepCompare{};
+	uint64_t lockstepFrame{};
+	IG::ByteBuffer lockstepState;
+	SH2LockstepSnapshot lockstepDynarecResult;
+	#endif
+
 	SaturnSystem(ApplicationContext ctx):
 		EmuSystem{ctx}
 	{
@@ -43,6 +71,9 @@ public:
 	std::string_view stateFilenameExt() const { return ".yss"; }
 	void loadState(EmuApp &, CStringView uri);
 	void saveState(CStringView path);
+	size_t stateSize();
+	size_t writeState(std::span<uint8_t> buff);
+	void readState(std::span<const uint8_t> buff);
 	bool readConfig(ConfigType, MapIO &, unsigned key, size_t readSize);
 	void writeConfig(ConfigType, FileIO &);
 	void reset(EmuApp &, ResetMode mode);
@@ -57,10 +88,17 @@ public:
 	void closeSystem();
 	void onFlushBackupMemory(EmuApp &, BackupMemoryDirtyFlags);
 	void onOptionsLoaded();
+
+private:
+	#ifdef SH2_DYNAREC
+	void runSH2LockstepDynarecPass();
+	void finishSH2LockstepFrame();
+	#endif
 };
 
 using MainSystem = SaturnSystem;
 
 bool hasBIOSExtension(std::string_view name);
+bool useSoundThread();
 
 }
@@ -31,12 +31,32 @@ SH2Interface_struct *SH2CoreList[]
 	nullptr
 };
 
+#if !defined HAVE_Q68 && !defined HAVE_C68K
+#warning No 68K cores compiled in
+#endif
+
+M68K_struct *M68KCoreList[] =
+{
+	//&M68KDummy,
+	#ifdef HAVE_C68K
+	&M68KC68K,
+	#endif
+	#ifdef Q68_USE_JIT
+	&M68KQ68JIT,
+	#endif
+	#ifdef HAVE_Q68
+	&M68KQ68,
+	#endif
+	nullptr
+};
+
 namespace EmuEx
 {
 
 enum
 {
-	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280
+	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280, CFGKEY_M68K_CORE = 281,
+	CFGKEY_SOUND_THREAD = 282
 };
 
 static bool OptionSH2CoreIsValid(uint8_t val)
@@ -53,9 +73,23 @@ static bool OptionSH2CoreIsValid(uint8_t val)
 	return false;
 }
 
+static bool OptionM68KCoreIsValid(uint8_t val)
+{
+	for(const auto &coreI : M68KCoreList)
+	{
+		if(coreI && coreI->id == val)
+			return true;
+	}
+	logMsg("68K core option not valid");
+	return false;
+}
+
 const char *EmuSystem::configFilename = "SaturnEmu.config";
 Byte1Option optionSH2Core{CFGKEY_SH2_CORE, (uint8_t)defaultSH2CoreID, false, OptionSH2CoreIsValid};
 unsigned SH2Cores = std::size(SH2CoreList) - 1;
+Byte1Option optionM68KCore{CFGKEY_M68K_CORE, (uint8_t)defaultM68KCoreID, false, OptionM68KCoreIsValid};
+unsigned M68KCores = std::size(M68KCoreList) - 1;
+Byte1Option optionSoundThread{CFGKEY_SOUND_THREAD, 1};
 bool EmuApp::hasIcon = false;
 bool EmuSystem::hasSound = !(Config::envIsAndroid || Config::envIsIOS);
 int EmuSystem::forcedSoundRate = 44100;
@@ -74,6 +108,7 @@ std::span<const AspectRatioInfo> SaturnSystem::aspectRatioInfos()
 void SaturnSystem::onOptionsLoaded()
 {
 	yinit.sh2coretype = optionSH2Core;
+	yinit.m68kcoretype = optionM68KCore;
 }
 
 bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key, size_t readSize)
@@ -85,6 +120,8 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key, size_t r
 			case CFGKEY_BIOS_PATH:
 				return readStringOptionValue(io, readSize, biosPath);
 			case CFGKEY_SH2_CORE: return optionSH2Core.readFromIO(io, readSize);
+			case CFGKEY_M68K_CORE: return optionM68KCore.readFromIO(io, readSize);
+			case CFGKEY_SOUND_THREAD: return optionSoundThread.readFromIO(io, readSize);
 		}
 	}
 	return false;
@@ -96,6 +133,8 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 	{
 		writeStringOptionValue(io, CFGKEY_BIOS_PATH, biosPath);
 		optionSH2Core.writeWithKeyIfNotDefault(io);
+		optionM68KCore.writeWithKeyIfNotDefault(io);
+		optionSoundThread.writeWithKeyIfNotDefault(io);
 	}
 }
 
@@ -0,0 +1,105 @@
+/*  This file is part of Saturn.emu.
+
+	Saturn.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Saturn.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Saturn.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "threads"
+#include <imagine/thread/Semaphore.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/utility.h>
+#include <array>
+#include <thread>
+
+extern "C"
+{
+	#include <yabause/threads.h>
+}
+
+// Yabause subthread port on top of std::thread
+
+struct YabSem_struct
+{
+	std::counting_semaphore<1024> sem;
+
+	YabSem_struct(int value = 0): sem(value) {}
+};
+
+static std::array<std::thread, YAB_NUM_THREADS> threads;
+static std::array<YabSem_struct, YAB_NUM_THREADS> wakeSems;
+static thread_local int currentThreadId = -1;
+
+CLINK int YabThreadStart(unsigned int id, void (*func)(void *), void *arg)
+{
+	if(threads[id].joinable())
+	{
+		logErr("thread %u is already started", id);
+		return -1;
+	}
+	threads[id] = std::thread{[=]()
+	{
+		currentThreadId = id;
+		func(arg);
+	}};
+	return 0;
+}
+
+CLINK void YabThreadWait(unsigned int id)
+{
+	if(!threads[id].joinable())
+		return;
+	threads[id].join();
+}
+
+CLINK void YabThreadYield(void)
+{
+	std::this_thread::yield();
+}
+
+CLINK void YabThreadSleep(void)
+{
+	if(currentThreadId == -1)
+	{
+		logErr("YabThreadSleep() called outside a Yabause subthread");
+		return;
+	}
+	wakeSems[currentThreadId].sem.acquire();
+}
+
+CLINK void YabThreadRemoteSleep(unsigned int id) {}
+
+CLINK void YabThreadWake(unsigned int id)
+{
+	if(!threads[id].joinable())
+		return;
+	wakeSems[id].sem.release();
+}
+
+CLINK YabSem *YabSemCreate(int value)
+{
+	return new YabSem{value};
+}
+
+CLINK void YabSemFree(YabSem *sem)
+{
+	delete sem;
+}
+
+CLINK void YabSemPost(YabSem *sem)
+{
+	sem->sem.release();
+}
+
+CLINK void YabSemWait(YabSem *sem)
+{
+	sem->sem.acquire();
+}
@@ -23,6 +23,11 @@
 
 #include "q68/q68.h"
 
+#ifdef Q68_USE_JIT
+# include <string.h>
+# include <sys/mman.h>
+#endif
+
 /*************************************************************************/
 
 /**
@@ -52,6 +57,9 @@
 /* Interface function declarations (must come before interface definition) */
 
 static int m68kq68_init(void);
+#ifdef Q68_USE_JIT
+static int m68kq68_init_jit(void);
+#endif
 static void m68kq68_deinit(void);
 static void m68kq68_reset(void);
 
@@ -84,6 +92,14 @@ static void m68kq68_set_writew(M68K_WRITE *func);
 static uint32_t dummy_read(uint32_t address);
 static void dummy_write(uint32_t address, uint32_t data);
 
+#ifdef Q68_USE_JIT
+static int exec_init(void);
+static void exec_deinit(void);
+static void *exec_malloc(size_t size);
+static void *exec_realloc(void *ptr, size_t size);
+static void exec_free(void *ptr);
+#endif
+
 #ifdef NEED_TRAMPOLINE
 static uint32_t readb_trampoline(uint32_t address);
 static uint32_t readw_trampoline(uint32_t address);
@@ -130,6 +146,47 @@ M68K_struct M68KQ68 = {
     .SetWriteW   = m68kq68_set_writew,
 };
 
+#ifdef Q68_USE_JIT
+
+/* Same interface with dynamic translation enabled */
+
+M68K_struct M68KQ68JIT = {
+    .id          = M68KCORE_Q68JIT,
+    .Name        = "Q68 68k Dynamic Recompiler",
+
+    .Init        = m68kq68_init_jit,
+    .DeInit      = m68kq68_deinit,
+    .Reset       = m68kq68_reset,
+
+    .Exec        = m68kq68_exec,
+    .Sync        = m68kq68_sync,
+
+    .GetDReg     = m68kq68_get_dreg,
+    .GetAReg     = m68kq68_get_areg,
+    .GetPC       = m68kq68_get_pc,
+    .GetSR       = m68kq68_get_sr,
+    .GetUSP      = m68kq68_get_usp,
+    .GetMSP      = m68kq68_get_ssp,
+
+    .SetDReg     = m68kq68_set_dreg,
+    .SetAReg     = m68kq68_set_areg,
+    .SetPC       = m68kq68_set_pc,
+    .SetSR       = m68kq68_set_sr,
+    .SetUSP      = m68kq68_set_usp,
+    .SetMSP      = m68kq68_set_ssp,
+
+    .SetIRQ      = m68kq68_set_irq,
+    .WriteNotify = m68kq68_write_notify,
+
+    .SetFetch    = m68kq68_set_fetch,
+    .SetReadB    = m68kq68_set_readb,
+    .SetReadW    = m68kq68_set_readw,
+    .SetWriteB   = m68kq68_set_writeb,
+    .SetWriteW   = m68kq68_set_writew,
+};
+
+#endif  // Q68_USE_JIT
+
 /*-----------------------------------------------------------------------*/
 
 /* Virtual processor state block */
@@ -163,6 +220,9 @@ static int m68kq68_init(void)
     if (!(state = q68_create())) {
         return -1;
     }
+#ifdef Q68_USE_JIT
+    q68_set_jit_enabled(state, 0);
+#endif
     q68_set_irq(state, 0);
     q68_set_readb_func(state, dummy_read);
     q68_set_readw_func(state, dummy_read);
@@ -174,6 +234,36 @@ static int m68kq68_init(void)
 
 /*-----------------------------------------------------------------------*/
 
+#ifdef Q68_USE_JIT
+
+/**
+ * m68kq68_init_jit:  Initialize the virtual processor with dynamic
+ * translation enabled.
+ *
+ * [Parameters]
+ *     None
+ * [Return value]
+ *     Zero on success, negative on failure
+ */
+static int m68kq68_init_jit(void)
+{
+    if (m68kq68_init() != 0) {
+        return -1;
+    }
+    /* Only translated code needs executable memory */
+    if (exec_init() != 0) {
+        m68kq68_deinit();
+        return -1;
+    }
+    q68_set_jit_memory_funcs(state, exec_malloc, exec_realloc, exec_free);
+    q68_set_jit_enabled(state, 1);
+    return 0;
+}
+
+#endif
+
+/*-----------------------------------------------------------------------*/
+
 /**
  * m68kq68_deinit:  Destroy the virtual processor.
  *
@@ -186,6 +276,10 @@ static void m68kq68_deinit(void)
 {
     q68_destroy(state);
     state = NULL;
+#ifdef Q68_USE_JIT
+    /* Only mapped by m68kq68_init_jit() */
+    exec_deinit();
+#endif
 }
 
 /*-----------------------------------------------------------------------*/
@@ -489,6 +583,151 @@ static void dummy_write(uint32_t address, uint32_t data)
 
 /*-----------------------------------------------------------------------*/
 
+#ifdef Q68_USE_JIT
+
+/**
+ * EXEC_ARENA_SIZE:  Size of the single executable mapping that translated
+ * code is allocated from.  Q68 starts discarding translated blocks once
+ * they total Q68_JIT_DATA_LIMIT bytes, so this leaves room for
+ * fragmentation; allocations that don't fit just fail, and the code is
+ * interpreted instead.
+ */
+#define EXEC_ARENA_SIZE  (4*1024*1024)
+
+#define EXEC_HEADER_SIZE 16  // Keeps the returned pointer 16-byte aligned
+#define EXEC_MIN_SPLIT   64  // Smallest free block worth splitting off
+
+/* Free blocks in the arena, kept in address order so neighbors merge */
+typedef struct ExecFreeBlock_ {
+    size_t size;  // Including the header
+    struct ExecFreeBlock_ *next;
+} ExecFreeBlock;
+
+static uint8_t *exec_arena;
+static ExecFreeBlock *exec_free_list;
+
+/**
+ * exec_init, exec_deinit:  Map or unmap the executable code arena.
+ *
+ * [Parameters]
+ *     None
+ * [Return value]
+ *     Zero on success, negative on failure (exec_init only)
+ */
+static int exec_init(void) {
+    exec_arena = mmap(NULL, EXEC_ARENA_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (exec_arena == MAP_FAILED) {
+        exec_arena = NULL;
+        return -1;
+    }
+    exec_free_list = (ExecFreeBlock *)exec_arena;
+    exec_free_list->size = EXEC_ARENA_SIZE;
+    exec_free_list->next = NULL;
+    return 0;
+}
+
+static void exec_deinit(void) {
+    if (exec_arena) {
+        munmap(exec_arena, EXEC_ARENA_SIZE);
+        exec_arena = NULL;
+        exec_free_list = NULL;
+    }
+}
+
+/**
+ * exec_malloc, exec_realloc, exec_free:  Memory allocation functions for
+ * Q68's translated code, returning executable memory from the code arena.
+ * Each block has its size stored in a header before it.
+ *
+ * [Parameters]
+ *      ptr: Block to resize or free (NULL is allowed)
+ *     size: Size of block to allocate in bytes
+ * [Return value]
+ *     Allocated block (only for exec_malloc and exec_realloc), or NULL on
+ *     failure
+ */
+
+static size_t exec_block_size(size_t size) {
+    return (size + EXEC_HEADER_SIZE + 15) & ~(size_t)15;
+}
+
+static void *exec_malloc(size_t size) {
+    const size_t need = exec_block_size(size);
+    ExecFreeBlock **link;
+    for (link = &exec_free_list; *link; link = &(*link)->next) {
+        ExecFreeBlock *block = *link;
+        if (block->size < need) {
+            continue;
+        }
+        if (block->size - need >= EXEC_MIN_SPLIT) {
+            ExecFreeBlock *rest = (ExecFreeBlock *)((uint8_t *)block + need);
+            rest->size = block->size - need;
+            rest->next = block->next;
+            *link = rest;
+            block->size = need;
+        } else {
+            *link = block->next;
+        }
+        return (uint8_t *)block + EXEC_HEADER_SIZE;
+    }
+    return NULL;
+}
+
+static void *exec_realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return exec_malloc(size);
+    }
+    ExecFreeBlock *block = (ExecFreeBlock *)((uint8_t *)ptr - EXEC_HEADER_SIZE);
+    const size_t need = exec_block_size(size);
+    if (need <= block->size) {
+        // Give the unused tail back to the arena when shrinking
+        if (block->size - need >= EXEC_MIN_SPLIT) {
+            ExecFreeBlock *rest = (ExecFreeBlock *)((uint8_t *)block + need);
+            rest->size = block->size - need;
+            block->size = need;
+            exec_free((uint8_t *)rest + EXEC_HEADER_SIZE);
+        }
+        return ptr;
+    }
+    void *new_ptr = exec_malloc(size);
+    if (!new_ptr) {
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, block->size - EXEC_HEADER_SIZE);
+    exec_free(ptr);
+    return new_ptr;
+}
+
+static void exec_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    ExecFreeBlock *block = (ExecFreeBlock *)((uint8_t *)ptr - EXEC_HEADER_SIZE);
+    ExecFreeBlock *prev = NULL, *next = exec_free_list;
+    while (next && next < block) {
+        prev = next;
+        next = next->next;
+    }
+    block->next = next;
+    if (next && (uint8_t *)block + block->size == (uint8_t *)next) {
+        block->size += next->size;
+        block->next = next->next;
+    }
+    if (prev && (uint8_t *)prev + prev->size == (uint8_t *)block) {
+        prev->size += block->size;
+        prev->next = block->next;
+    } else if (prev) {
+        prev->next = block;
+    } else {
+        exec_free_list = block;
+    }
+}
+
+#endif  // Q68_USE_JIT
+
+/*-----------------------------------------------------------------------*/
+
 #ifdef NEED_TRAMPOLINE
 
 /**
@@ -992,10 +992,9 @@ void FormatBackupRam(void *mem, u32 size)
 //    [sh2core.c] frc.div changed to frc.shift
 //    [sh2core.c] wdt probably needs to be written as well
 
-int YabSaveState(const char *filename)
+int YabSaveStateStream(FILE *fp, int dataOnly)
 {
    u32 i;
-   FILE *fp;
    int offset;
    IOCheck_struct check;
    u8 *buf;
@@ -1006,17 +1005,11 @@ int YabSaveState(const char *filename)
    int temp;
    u32 temp32;
 
+   long statesize;
+
    check.done = 0;
    check.size = 0;
 
-   //use a second set of savestates for movies
-   filename = MakeMovieStateName(filename);
-   if (!filename)
-      return -1;
-
-   if ((fp = fopen(filename, "wb")) == NULL)
-      return -1;
-
    // Write signature
    fprintf(fp, "YSS");
 
@@ -1072,34 +1065,46 @@ int YabSaveState(const char *filename)
    ywrite(&check, (void *)&yabsys.CurSH2FreqType, sizeof(int), 1, fp);
    ywrite(&check, (void *)&yabsys.IsPal, sizeof(int), 1, fp);
 
-   VIDCore->GetGlSize(&outputwidth, &outputheight);
-
-   totalsize=outputwidth * outputheight * sizeof(u32);
-
-   if ((buf = (u8 *)malloc(totalsize)) == NULL)
+   // data only states skip the screenshot and movie
+   if (dataOnly)
    {
-      return -2;
+      outputwidth = outputheight = 0;
+      ywrite(&check, (void *)&outputwidth, sizeof(outputwidth), 1, fp);
+      ywrite(&check, (void *)&outputheight, sizeof(outputheight), 1, fp);
+      movieposition=ftell(fp);
    }
+   else
+   {
+      VIDCore->GetGlSize(&outputwidth, &outputheight);
 
-   YuiSwapBuffers();
-   #ifdef USE_OPENGL
-   glPixelZoom(1,1);
-   glReadBuffer(GL_BACK);
-   glReadPixels(0, 0, outputwidth, outputheight, GL_RGBA, GL_UNSIGNED_BYTE, buf);
-   #endif
-   YuiSwapBuffers();
+      totalsize=outputwidth * outputheight * sizeof(u32);
 
-   ywrite(&check, (void *)&outputwidth, sizeof(outputwidth), 1, fp);
-   ywrite(&check, (void *)&outputheight, sizeof(outputheight), 1, fp);
+      if ((buf = (u8 *)malloc(totalsize)) == NULL)
+      {
+         return -2;
+      }
 
-   ywrite(&check, (void *)buf, totalsize, 1, fp);
-   free(buf);
+      YuiSwapBuffers();
+      #ifdef USE_OPENGL
+      glPixelZoom(1,1);
+      glReadBuffer(GL_BACK);
+      glReadPixels(0, 0, outputwidth, outputheight, GL_RGBA, GL_UNSIGNED_BYTE, buf);
+      #endif
+      YuiSwapBuffers();
+
+      ywrite(&check, (void *)&outputwidth, sizeof(outputwidth), 1, fp);
+      ywrite(&check, (void *)&outputheight, sizeof(outputheight), 1, fp);
 
-   movieposition=ftell(fp);
-   //write the movie to the end of the savestate
-   SaveMovieInState(fp, check);
+      ywrite(&check, (void *)buf, totalsize, 1, fp);
+      free(buf);
+
+      movieposition=ftell(fp);
+      //write the movie to the end of the savestate
+      SaveMovieInState(fp, check);
+   }
 
    i += StateFinishHeader(fp, offset);
+   statesize = ftell(fp);
 
    // Go back and update size
    fseek(fp, 8, SEEK_SET);
@@ -1107,8 +1112,30 @@ int YabSaveState(const char *filename)
    fseek(fp, 16, SEEK_SET);
    ywrite(&check, (void *)&movieposition, sizeof(movieposition), 1, fp);
 
+   return statesize;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+int YabSaveState(const char *filename)
+{
+   FILE *fp;
+   int ret;
+
+   //use a second set of savestates for movies
+   filename = MakeMovieStateName(filename);
+   if (!filename)
+      return -1;
+
+   if ((fp = fopen(filename, "wb")) == NULL)
+      return -1;
+
+   ret = YabSaveStateStream(fp, 0);
    fclose(fp);
 
+   if (ret < 0)
+      return ret;
+
    OSDPushMessage(OSDMSG_STATUS, 150, "STATE SAVED");
 
    return 0;
@@ -1116,9 +1143,8 @@ int YabSaveState(const char *filename)
 
 //////////////////////////////////////////////////////////////////////////////
 
-int YabLoadState(const char *filename)
+int YabLoadStateStream(FILE *fp, const char *filename)
 {
-   FILE *fp;
    char id[3];
    u8 endian;
    int headerversion, version, size, chunksize, headersize;
@@ -1133,13 +1159,6 @@ int YabLoadState(const char *filename)
    int temp;
    u32 temp32;
 
-   filename = MakeMovieStateName(filename);
-   if (!filename)
-      return -1;
-
-   if ((fp = fopen(filename, "rb")) == NULL)
-      return -1;
-
    headersize = 0xC;
 
    // Read signature
@@ -1147,7 +1166,6 @@ int YabLoadState(const char *filename)
 
    if (strncmp(id, "YSS", 3) != 0)
    {
-      fclose(fp);
       return -2;
    }
 
@@ -1170,7 +1188,6 @@ int YabLoadState(const char *filename)
       default:
          /* we're trying to open a save state using a future version
           * of the YSS format, that won't work, sorry :) */
-         fclose(fp);
          return -3;
          break;
    }
@@ -1183,7 +1200,6 @@ int YabLoadState(const char *filename)
    {
       // should setup reading so it's byte-swapped
       YabSetError(YAB_ERR_OTHER, (void *)"Load State byteswapping not supported");
-      fclose(fp);
       return -3;
    }
 
@@ -1192,7 +1208,6 @@ int YabLoadState(const char *filename)
 
    if (size != (ftell(fp) - headersize))
    {
-      fclose(fp);
       return -2;
    }
    fseek(fp, headersize, SEEK_SET);
@@ -1203,7 +1218,6 @@ int YabLoadState(const char *filename)
    
    if (StateCheckRetrieveHeader(fp, "CART", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1212,7 +1226,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "CS2 ", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1221,7 +1234,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "MSH2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1230,7 +1242,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SSH2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1239,7 +1250,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SCSP", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1248,7 +1258,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SCU ", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1257,7 +1266,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SMPC", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1266,7 +1274,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "VDP1", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1275,7 +1282,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "VDP2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1284,7 +1290,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "OTHR", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1313,38 +1318,67 @@ int YabLoadState(const char *filename)
 
    totalsize=outputwidth * outputheight * sizeof(u32);
 
-   if ((buf = (u8 *)malloc(totalsize)) == NULL)
+   // data only states have no screenshot or movie
+   if (totalsize)
    {
-      return -2;
-   }
+      if ((buf = (u8 *)malloc(totalsize)) == NULL)
+      {
+         ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
+         return -2;
+      }
 
-   yread(&check, (void *)buf, totalsize, 1, fp);
-   free(buf);
+      yread(&check, (void *)buf, totalsize, 1, fp);
+      free(buf);
 
-   YuiSwapBuffers();
+      YuiSwapBuffers();
 
-   #ifdef USE_OPENGL
-   if(VIDCore->id == VIDCORE_SOFT)
-     glRasterPos2i(0, outputheight);
-   if(VIDCore->id == VIDCORE_OGL)
-	 glRasterPos2i(0, outputheight/2);
-   #endif
+      #ifdef USE_OPENGL
+      if(VIDCore->id == VIDCORE_SOFT)
+        glRasterPos2i(0, outputheight);
+      if(VIDCore->id == VIDCORE_OGL)
+        glRasterPos2i(0, outputheight/2);
+      #endif
 
-   VIDCore->GetGlSize(&curroutputwidth, &curroutputheight);
-   #ifdef USE_OPENGL
-   glPixelZoom((float)curroutputwidth / (float)outputwidth, ((float)curroutputheight / (float)outputheight));
-   glDrawPixels(outputwidth, outputheight, GL_RGBA, GL_UNSIGNED_BYTE, buf);
-   #endif
-   YuiSwapBuffers();
+      VIDCore->GetGlSize(&curroutputwidth, &curroutputheight);
+      #ifdef USE_OPENGL
+      glPixelZoom((float)curroutputwidth / (float)outputwidth, ((float)curroutputheight / (float)outputheight));
+      glDrawPixels(outputwidth, outputheight, GL_RGBA, GL_UNSIGNED_BYTE, buf);
+      #endif
+      YuiSwapBuffers();
+   }
 
-   fseek(fp, movieposition, SEEK_SET);
-   MovieReadState(fp, filename);
+   if (filename)
+   {
+      fseek(fp, movieposition, SEEK_SET);
+      MovieReadState(fp, filename);
+   }
    }
-   
-   fclose(fp);
 
    ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
 
+   return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+int YabLoadState(const char *filename)
+{
+   FILE *fp;
+   int ret;
+
+   filename = MakeMovieStateName(filename);
+   if (!filename)
+      return -1;
+
+   if ((fp = fopen(filename, "rb")) == NULL)
+      return -1;
+
+   ret = YabLoadStateStream(fp, filename);
+   fclose(fp);
+
+   if (ret != 0)
+      return ret;
+
    OSDPushMessage(OSDMSG_STATUS, 150, "STATE LOADED");
 
    return 0;
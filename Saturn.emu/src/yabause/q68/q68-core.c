@@ -218,6 +218,7 @@ void q68_reset(Q68State *state)
     state->fault_opcode = 0;
     state->fault_status = 0;
     state->jit_running = NULL;
+    state->jit_enabled = state->jit_enabled_next;
 #ifdef Q68_USE_JIT
     q68_jit_reset(state);
 #endif
@@ -263,7 +264,7 @@ int q68_run(Q68State *state, int cycles)
             }
         }
 #ifdef Q68_USE_JIT
-        if (!state->jit_running) {
+        if (!state->jit_running && state->jit_enabled) {
             state->jit_running = q68_jit_find(state, state->PC);
             if (UNLIKELY(!state->jit_running)) {
                 state->jit_running = q68_jit_translate(state, state->PC);
@@ -1446,7 +1447,9 @@ static int op_MUL(Q68State *state, uint32_t opcode)
     if (sign) {
         state->D[reg] = (int16_t)state->D[reg] * (int16_t)data;
     } else {
-        state->D[reg] = (uint16_t)state->D[reg] * data;
+        /* Multiply as unsigned int so a product above INT_MAX isn't
+         * signed overflow (which lets the compiler drop the N check) */
+        state->D[reg] = (uint32_t)(uint16_t)state->D[reg] * data;
     }
     INSN_CLEAR_CC();
     INSN_SETNZ(state->D[reg]);
@@ -1566,11 +1569,11 @@ static int opshft(Q68State *state, uint32_t opcode)
                 }
                 data <<= 1;
             } else {
-                data = (int32_t)data >> (count-1);
+                data >>= count-1;
                 if (data & 1) {
                     state->SR |= SR_X | SR_C;
                 }
-                data = (int32_t)data >> 1;
+                data >>= 1;
             }
             break;
           case 2: {  // ROXL/ROXR
@@ -1596,18 +1599,16 @@ static int opshft(Q68State *state, uint32_t opcode)
           }
           default: {  // (case 3) ROL/ROR
             count %= nbits;
-            if (is_left) {
-                data = (data << count) | (data >> (nbits - count));
-                if ((data >> (nbits-1)) & 1) {
-                    state->SR |= SR_C;
-                }
-                data <<= 1;
-            } else {
-                data = (data >> count) | (data << (nbits - count));
-                if (data & 1) {
-                    state->SR |= SR_C;
+            if (count > 0) {  // Avoid an undefined shift by nbits
+                if (is_left) {
+                    data = (data << count) | (data >> (nbits - count));
+                } else {
+                    data = (data >> count) | (data << (nbits - count));
                 }
-                data = (int32_t)data >> 1;
+            }
+            /* C is the last bit rotated out, which is now at the other end */
+            if (is_left ? data & 1 : (data >> (nbits-1)) & 1) {
+                state->SR |= SR_C;
             }
             break;
           }
@@ -1789,7 +1790,9 @@ static int opMVSR(Q68State *state, uint32_t opcode)
         }
         ea_set(state, opcode, SIZE_W, value);
     } else {
-        if (!is_CCR) {
+        if (is_CCR) {
+            state->SR = (state->SR & 0xFF00) | (value & 0x00FF);
+        } else {
             set_SR(state, value);
         }
     }
@@ -184,6 +184,11 @@ struct Q68State_ {
     void *(*realloc_func)(void *ptr, size_t size);
     void (*free_func)(void *ptr);
 
+    /* Native memory allocation functions for translated code (for JIT) */
+    void *(*code_malloc_func)(size_t size);
+    void *(*code_realloc_func)(void *ptr, size_t size);
+    void (*code_free_func)(void *ptr);
+
     /* 68k memory read/write functions */
     Q68ReadFunc *readb_func, *readw_func;
     Q68WriteFunc *writeb_func, *writew_func;
@@ -236,6 +241,11 @@ struct Q68State_ {
     /* Buffer for tracking translated code blocks */
     uint8_t jit_pages[1<<(24-(Q68_JIT_PAGE_BITS+3))];
 
+    /* Nonzero if dynamic translation is used; jit_enabled_next is copied
+     * to jit_enabled on reset.  (These are kept after all fields accessed
+     * from the assembly routines so the hardcoded offsets stay valid.) */
+    unsigned int jit_enabled, jit_enabled_next;
+
 };
 
 /*-----------------------------------------------------------------------*/
@@ -595,7 +595,7 @@ Q68JitEntry *q68_jit_translate(Q68State *state, uint32_t address)
 
     /* Initialize the new entry */
 
-    current_entry->native_code = state->malloc_func(Q68_JIT_BLOCK_EXPAND_SIZE);
+    current_entry->native_code = state->code_malloc_func(Q68_JIT_BLOCK_EXPAND_SIZE);
     if (!current_entry->native_code) {
         DMSG("No memory for code at $%06X", address);
         current_entry = NULL;
@@ -663,8 +663,8 @@ Q68JitEntry *q68_jit_translate(Q68State *state, uint32_t address)
     ) {
         JIT_PAGE_SET(state, index);
     }
-    void *newptr = state->realloc_func(current_entry->native_code,
-                                       current_entry->native_length);
+    void *newptr = state->code_realloc_func(current_entry->native_code,
+                                            current_entry->native_length);
     if (newptr) {
         current_entry->native_code = newptr;
         current_entry->native_size = current_entry->native_length;
@@ -778,10 +778,11 @@ void q68_jit_run(Q68State *state, uint32_t cycle_limit,
     }
 
     /* If we finished a block, we still have cycles to go, there's no
-     * exception pending, and there's already a translated block at the
-     * next PC, jump right to it so we don't incur the extra overhead of
-     * returning to the caller */
-    if (!entry && state->cycles < cycle_limit && !state->exception) {
+     * exception pending, the processor wasn't halted by STOP, and
+     * there's already a translated block at the next PC, jump right to
+     * it so we don't incur the extra overhead of returning to the caller */
+    if (!entry && state->cycles < cycle_limit && !state->exception
+     && !state->halted) {
         entry = q68_jit_find(state, state->PC);
         if (entry) {
             goto again;
@@ -1079,7 +1080,7 @@ static void clear_entry(Q68State *state, Q68JitEntry *entry)
 
     /* Free the native code */
     state->jit_total_data -= entry->native_size;
-    state->free_func(entry->native_code);
+    state->code_free_func(entry->native_code);
     entry->native_code = NULL;
 
     /* Clear the entry from the table and hash chain */
@@ -1144,7 +1145,7 @@ static void clear_oldest_entry(Q68State *state)
 static int expand_buffer(Q68JitEntry *entry)
 {
     const uint32_t newsize = entry->native_size + Q68_JIT_BLOCK_EXPAND_SIZE;
-    void *newptr = entry->state->realloc_func(entry->native_code, newsize);
+    void *newptr = entry->state->code_realloc_func(entry->native_code, newsize);
     if (!newptr) {
         DMSG("Out of memory");
         return 0;
@@ -3425,12 +3426,15 @@ static int op4E7x(Q68State *state, uint32_t opcode)
       case 1:  // $4E71 NOP
         JIT_EMIT_ADD_CYCLES(current_entry, 4);
         return 0;
-      case 2:  // $4E72 STOP
+      case 2: {  // $4E72 STOP
         JIT_EMIT_CHECK_SUPER(current_entry);
         JIT_EMIT_ADD_CYCLES(current_entry, 4);
+        /* Fetch the new SR first so the PC ends up past the immediate */
+        const uint16_t newSR = IFETCH(state);
         advance_PC(state);
-        JIT_EMIT_STOP(current_entry, IFETCH(state));
+        JIT_EMIT_STOP(current_entry, newSR);
         return 1;
+      }
       case 3: {  // $4E73 RTE
         JIT_EMIT_CHECK_SUPER(current_entry);
 #ifndef Q68_DISABLE_ADDRESS_ERROR
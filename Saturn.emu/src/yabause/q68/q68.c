@@ -89,13 +89,20 @@ Q68State *q68_create_ex(void *(*malloc_func)(size_t size),
     state->malloc_func  = malloc_func;
     state->realloc_func = realloc_func;
     state->free_func    = free_func;
+    state->code_malloc_func  = malloc_func;
+    state->code_realloc_func = realloc_func;
+    state->code_free_func    = free_func;
 
 #ifdef Q68_USE_JIT
     if (!q68_jit_init(state)) {
         state->free_func(state);
         return NULL;
     }
+    state->jit_enabled_next = 1;
+#else
+    state->jit_enabled_next = 0;
 #endif
+    state->jit_enabled = 0;
 
     state->halted = Q68_HALTED_DOUBLE_FAULT; // Let's initialize this, at least
     return state;
@@ -197,6 +204,53 @@ void q68_set_jit_flush_func(Q68State *state, void (*flush_func)(void))
     state->jit_flush   = flush_func;
 }
 
+/*-----------------------------------------------------------------------*/
+
+/**
+ * q68_set_jit_memory_funcs:  Set the functions used to allocate memory for
+ * translated native code, which must be executable.  By default the
+ * functions passed to q68_create_ex() are used.  This must be called
+ * before any code is translated.  This function has no effect if dynamic
+ * translation is not enabled.
+ *
+ * [Parameters]
+ *            state: Processor state block
+ *      malloc_func: Function for allocating a memory block
+ *     realloc_func: Function for adjusting the size of a memory block
+ *        free_func: Function for freeing a memory block
+ * [Return value]
+ *     None
+ */
+void q68_set_jit_memory_funcs(Q68State *state,
+                              void *(*malloc_func)(size_t size),
+                              void *(*realloc_func)(void *ptr, size_t size),
+                              void (*free_func)(void *ptr))
+{
+    state->code_malloc_func  = malloc_func;
+    state->code_realloc_func = realloc_func;
+    state->code_free_func    = free_func;
+}
+
+/*-----------------------------------------------------------------------*/
+
+/**
+ * q68_set_jit_enabled:  Enable or disable dynamic translation at runtime.
+ * Translation is enabled by default when built with Q68_USE_JIT; when
+ * disabled, all code is run through the interpreter.  This function has
+ * no effect if dynamic translation is not built in.  The change takes
+ * effect at the next call to q68_reset().
+ *
+ * [Parameters]
+ *       state: Processor state block
+ *     enabled: Nonzero to enable dynamic translation, zero to disable
+ * [Return value]
+ *     None
+ */
+void q68_set_jit_enabled(Q68State *state, int enabled)
+{
+    state->jit_enabled_next = (enabled != 0);
+}
+
 /*************************************************************************/
 
 /**
@@ -265,6 +319,7 @@ void q68_set_areg(Q68State *state, int num, uint32_t value)
 void q68_set_pc(Q68State *state, uint32_t value)
 {
     state->PC = value;
+    state->jit_running = NULL;  // Don't resume a block at the old address
 }
 
 void q68_set_sr(Q68State *state, uint16_t value)
@@ -153,6 +153,41 @@ extern void q68_set_writew_func(Q68State *state, Q68WriteFunc func);
  */
 extern void q68_set_jit_flush_func(Q68State *state, void (*flush_func)(void));
 
+/**
+ * q68_set_jit_memory_funcs:  Set the functions used to allocate memory for
+ * translated native code, which must be executable.  By default the
+ * functions passed to q68_create_ex() are used.  This must be called
+ * before any code is translated.  This function has no effect if dynamic
+ * translation is not enabled.
+ *
+ * [Parameters]
+ *            state: Processor state block
+ *      malloc_func: Function for allocating a memory block
+ *     realloc_func: Function for adjusting the size of a memory block
+ *        free_func: Function for freeing a memory block
+ * [Return value]
+ *     None
+ */
+extern void q68_set_jit_memory_funcs(Q68State *state,
+                                     void *(*malloc_func)(size_t size),
+                                     void *(*realloc_func)(void *ptr, size_t size),
+                                     void (*free_func)(void *ptr));
+
+/**
+ * q68_set_jit_enabled:  Enable or disable dynamic translation at runtime.
+ * Translation is enabled by default when built with Q68_USE_JIT; when
+ * disabled, all code is run through the interpreter.  This function has
+ * no effect if dynamic translation is not built in.  The change takes
+ * effect at the next call to q68_reset().
+ *
+ * [Parameters]
+ *       state: Processor state block
+ *     enabled: Nonzero to enable dynamic translation, zero to disable
+ * [Return value]
+ *     None
+ */
+extern void q68_set_jit_enabled(Q68State *state, int enabled);
+
 /*----------------------------------*/
 
 /**
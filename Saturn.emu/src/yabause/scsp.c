@@ -91,6 +91,7 @@
 #include "memory.h"
 #include "m68kcore.h"
 #include "scu.h"
+#include "threads.h"
 #include "yabause.h"
 #include "scsp.h"
 
@@ -286,6 +287,7 @@ typedef struct scsp_t
   u32 mcipd;            // pending main cpu interrupt
 
   u8 *scsp_ram;         // scsp ram pointer
+  u8 *slot_ram;         // ram the slots play samples from
   void (*mintf)(void);  // main cpu interupt function pointer
   void (*sintf)(u32);   // sound cpu interrupt function pointer
 
@@ -336,6 +338,30 @@ static union {
 static unsigned int cdda_next_in=0;               // Next sector buffer offset to receive into
 static u32 cdda_out_left;                       // Bytes of CDDA left to output
 
+// When sound is generated on its own thread (see ScspSetThreaded()), slot
+// register writes update the register file right away but their effect
+// on the slots is queued with the sample they were made on, then replayed
+// by the sound thread while it generates the frame
+typedef struct
+{
+  u32 time;     // sample offset in the frame
+  u16 addr;     // slot register address
+  u16 data;
+  u8 slot;
+  u8 size;      // 1 = byte write, 2 = word write
+} scsp_write_t;
+
+typedef struct
+{
+  scsp_write_t *write;
+  u32 num;
+  u32 max;
+} scsp_write_queue_t;
+
+static int scsp_queue_writes;                   // True to queue slot writes
+static u32 scsp_frame_time;                     // Samples elapsed this frame
+static scsp_write_queue_t scsp_write_queue;     // Writes made this frame
+
 ////////////////////////////////////////////////////////////////
 
 static void scsp_env_null_next(slot_t *slot);
@@ -456,13 +482,13 @@ scsp_slot_keyon (slot_t *slot)
       // set buffer, loop start/end address of the slot
       if (slot->pcm8b)
         {
-          slot->buf8 = (s8*) &(scsp.scsp_ram[slot->sa]);
+          slot->buf8 = (s8*) &(scsp.slot_ram[slot->sa]);
           if ((slot->sa + (slot->lea >> SCSP_FREQ_LB)) > SCSP_RAM_MASK)
             slot->lea = (SCSP_RAM_MASK - slot->sa) << SCSP_FREQ_LB;
         }
       else
         {
-          slot->buf16 = (s16*) &(scsp.scsp_ram[slot->sa & ~1]);
+          slot->buf16 = (s16*) &(scsp.slot_ram[slot->sa & ~1]);
           if ((slot->sa + (slot->lea >> (SCSP_FREQ_LB - 1))) > SCSP_RAM_MASK)
             slot->lea = (SCSP_RAM_MASK - slot->sa) << (SCSP_FREQ_LB - 1);
         }
@@ -590,14 +616,12 @@ scsp_slot_refresh_einc (slot_t *slot, u32 adsr_bitmask)
 }
 
 static void
-scsp_slot_set_b (u32 s, u32 a, u8 d)
+scsp_slot_apply_b (u32 s, u32 a, u8 d)
 {
   slot_t *slot = &(scsp.slot[s]);
 
   SCSPLOG("slot %d : reg %.2X = %.2X\n", s, a & 0x1F, d);
 
-  scsp_isr[a ^ 3] = d;
-
   switch (a & 0x1F)
     {
     case 0x00: // KX/KB/SBCTL/SSCTL(high bit)
@@ -883,14 +907,12 @@ scsp_slot_set_b (u32 s, u32 a, u8 d)
 }
 
 static void
-scsp_slot_set_w (u32 s, s32 a, u16 d)
+scsp_slot_apply_w (u32 s, s32 a, u16 d)
 {
   slot_t *slot = &(scsp.slot[s]);
 
   SCSPLOG ("slot %d : reg %.2X = %.4X\n", s, a & 0x1E, d);
 
-  *(u16 *)&scsp_isr[a ^ 2] = d;
-
   switch (a & 0x1E)
     {
     case 0x00: // KYONEX/KYONB/SBCTL/SSCTL/LPCTL/PCM8B/SA(highest 4 bits)
@@ -1116,6 +1138,65 @@ scsp_slot_set_w (u32 s, s32 a, u16 d)
     }
 }
 
+static void
+scsp_queue_write (u32 s, u32 a, u16 d, u8 size)
+{
+  scsp_write_queue_t *queue = &scsp_write_queue;
+  scsp_write_t *write;
+
+  if (queue->num == queue->max)
+    {
+      u32 newmax = queue->max ? queue->max * 2 : 256;
+      scsp_write_t *newwrite = (scsp_write_t *)realloc(queue->write,
+                                                        newmax * sizeof(scsp_write_t));
+      if (newwrite == NULL)
+        {
+          SCSPLOG ("ERROR: can't grow slot write queue, write dropped\n");
+          return;
+        }
+      queue->write = newwrite;
+      queue->max = newmax;
+    }
+
+  write = &queue->write[queue->num++];
+  write->time = scsp_frame_time;
+  write->addr = a;
+  write->data = d;
+  write->slot = s;
+  write->size = size;
+}
+
+static void
+scsp_apply_write (const scsp_write_t *write)
+{
+  if (write->size == 1)
+    scsp_slot_apply_b (write->slot, write->addr, write->data);
+  else
+    scsp_slot_apply_w (write->slot, write->addr, write->data);
+}
+
+static void
+scsp_slot_set_b (u32 s, u32 a, u8 d)
+{
+  scsp_isr[a ^ 3] = d;
+
+  if (scsp_queue_writes)
+    scsp_queue_write (s, a, d, 1);
+  else
+    scsp_slot_apply_b (s, a, d);
+}
+
+static void
+scsp_slot_set_w (u32 s, s32 a, u16 d)
+{
+  *(u16 *)&scsp_isr[a ^ 2] = d;
+
+  if (scsp_queue_writes)
+    scsp_queue_write (s, a, d, 2);
+  else
+    scsp_slot_apply_w (s, a, d);
+}
+
 static u8
 scsp_slot_get_b (u32 s, u32 a)
 {
@@ -1189,7 +1270,9 @@ scsp_set_b (u32 a, u8 d)
 
     case 0x08: // MSLC
       scsp.mslc = (d >> 3) & 0x1F;
-      scsp_update_monitor ();
+      // The sound thread may be playing the slots, it's updated on collect
+      if (!scsp_queue_writes)
+        scsp_update_monitor ();
       return;
 
     case 0x12: // DMEAL(high byte)
@@ -1353,7 +1436,9 @@ scsp_set_w (u32 a, u16 d)
 
     case 0x08: // MSLC
       scsp.mslc = (d >> 11) & 0x1F;
-      scsp_update_monitor();
+      // The sound thread may be playing the slots, it's updated on collect
+      if (!scsp_queue_writes)
+        scsp_update_monitor();
       return;
 
     case 0x12: // DMEAL
@@ -1659,14 +1744,14 @@ scsp_slot_update_keyon (slot_t *slot)
   // set buffer, loop start/end address of the slot
   if (slot->pcm8b)
     {
-      slot->buf8 = (s8*)&(scsp.scsp_ram[slot->sa]);
+      slot->buf8 = (s8*)&(scsp.slot_ram[slot->sa]);
 
       if ((slot->sa + (slot->lea >> SCSP_FREQ_LB)) > SCSP_RAM_MASK)
         slot->lea = (SCSP_RAM_MASK - slot->sa) << SCSP_FREQ_LB;
     }
   else
     {
-      slot->buf16 = (s16*)&(scsp.scsp_ram[slot->sa & ~1]);
+      slot->buf16 = (s16*)&(scsp.slot_ram[slot->sa & ~1]);
 
       if ((slot->sa + (slot->lea >> (SCSP_FREQ_LB - 1))) > SCSP_RAM_MASK)
         slot->lea = (SCSP_RAM_MASK - slot->sa) << (SCSP_FREQ_LB - 1);
@@ -2272,8 +2357,8 @@ static void (*scsp_slot_update_p[2][2][2][2][2])(slot_t *slot) =
   }
 };
 
-void
-scsp_update (s32 *bufL, s32 *bufR, u32 len)
+static void
+scsp_update_slots (s32 *bufL, s32 *bufR, u32 len)
 {
   slot_t *slot;
 
@@ -2325,6 +2410,13 @@ scsp_update (s32 *bufL, s32 *bufR, u32 len)
                         [(slot->disll == 31)  ? 0 : 1]
                         [(slot->dislr == 31)  ? 0 : 1](slot);
     }
+}
+
+static void
+scsp_update_cdda (s32 *bufL, s32 *bufR, u32 len)
+{
+  scsp_bufL = bufL;
+  scsp_bufR = bufR;
 
   if (cdda_out_left > 0)
     {
@@ -2372,6 +2464,38 @@ scsp_update (s32 *bufL, s32 *bufR, u32 len)
   }
 }
 
+void
+scsp_update (s32 *bufL, s32 *bufR, u32 len)
+{
+  scsp_update_slots (bufL, bufR, len);
+  scsp_update_cdda (bufL, bufR, len);
+}
+
+// Generates len samples of slot output, applying each queued write once
+// the output has reached the sample it was made on
+static void
+scsp_update_queued (s32 *bufL, s32 *bufR, u32 len, scsp_write_queue_t *queue)
+{
+  u32 pos = 0;
+  u32 i;
+
+  for (i = 0; i < queue->num; i++)
+    {
+      u32 time = queue->write[i].time < len ? queue->write[i].time : len;
+
+      if (time > pos)
+        {
+          scsp_update_slots (bufL + pos, bufR + pos, time - pos);
+          pos = time;
+        }
+      scsp_apply_write (&queue->write[i]);
+    }
+  queue->num = 0;
+
+  if (pos < len)
+    scsp_update_slots (bufL + pos, bufR + pos, len - pos);
+}
+
 void
 scsp_update_monitor(void)
 {
@@ -2849,6 +2973,7 @@ scsp_init (u8 *scsp_ram, void (*sint_hand)(u32), void (*mint_hand)(void))
   scsp_dcr = &scsp_reg[0x0700];
 
   scsp.scsp_ram = scsp_ram;
+  scsp.slot_ram = scsp_ram;
   scsp.sintf = sint_hand;
   scsp.mintf = mint_hand;
 
@@ -2982,6 +3107,19 @@ static int scspframeaccurate;   // True to generate frame-accurate audio
 static u32 scspsoundgenpos;     // Offset of next byte to generate
 static u32 scspsoundoutleft;    // Samples not yet sent to host driver
 
+static struct
+{
+  int running;                  // True if the sound thread is started
+  int busy;                     // True while the thread generates a frame
+  int quit;                     // Set to make the thread exit
+  YabSem *start;                // Posted when a frame is ready to generate
+  YabSem *done;                 // Posted when the frame has been generated
+  s32 *bufL, *bufR;             // Output for the frame being generated
+  u32 len;
+  scsp_write_queue_t queue;     // Slot writes made during that frame
+  u8 *ram;                      // Sound RAM as of the end of that frame
+} scspthread;
+
 static int
 scsp_alloc_bufs (void)
 {
@@ -3002,6 +3140,105 @@ scsp_alloc_bufs (void)
   return 0;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+static void
+ScspThread (UNUSED void *arg)
+{
+  for (;;)
+    {
+      YabSemWait (scspthread.start);
+      if (scspthread.quit)
+        break;
+
+      scsp_update_queued (scspthread.bufL, scspthread.bufR, scspthread.len,
+                          &scspthread.queue);
+
+      YabSemPost (scspthread.done);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Waits for the frame being generated on the sound thread, if any, then
+// mixes in CD audio and makes it available for output
+static void
+ScspThreadCollect (void)
+{
+  if (!scspthread.busy)
+    return;
+
+  YabSemWait (scspthread.done);
+  scspthread.busy = 0;
+
+  scsp_update_monitor ();
+  scsp_update_cdda (scspthread.bufL, scspthread.bufR, scspthread.len);
+  scspsoundoutleft += scspthread.len;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Brings the slots up to date so they can be accessed from this thread,
+// applying writes made since the last frame without waiting for their sample
+static void
+ScspThreadSync (void)
+{
+  u32 i;
+
+  if (!scspthread.running)
+    return;
+
+  ScspThreadCollect ();
+
+  for (i = 0; i < scsp_write_queue.num; i++)
+    scsp_apply_write (&scsp_write_queue.write[i]);
+  scsp_write_queue.num = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Points the slot sample buffers into another copy of sound RAM
+static void
+ScspSetSlotRam (u8 *ram)
+{
+  u32 i;
+
+  for (i = 0; i < 32; i++)
+    {
+      slot_t *slot = &scsp.slot[i];
+
+      if (slot->buf8)
+        slot->buf8 = (s8 *)(ram + ((u8 *)slot->buf8 - scsp.slot_ram));
+      if (slot->buf16)
+        slot->buf16 = (s16 *)(ram + ((u8 *)slot->buf16 - scsp.slot_ram));
+    }
+
+  scsp.slot_ram = ram;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Hands the frame just emulated to the sound thread, which generates it
+// while the next frame is emulated
+static void
+ScspThreadGenerate (s32 *bufL, s32 *bufR, u32 len)
+{
+  scsp_write_queue_t queue = scspthread.queue;
+
+  scspthread.queue = scsp_write_queue;
+  scsp_write_queue = queue;
+  scsp_write_queue.num = 0;
+
+  // The 68K keeps writing sound RAM while the thread plays from it
+  memcpy (scspthread.ram, scsp.scsp_ram, SCSP_RAM_SIZE);
+
+  scspthread.bufL = bufL;
+  scspthread.bufR = bufR;
+  scspthread.len = len;
+  scspthread.busy = 1;
+  YabSemPost (scspthread.start);
+}
+
 static u8 IsM68KRunning;
 static s32 FASTCALL (*m68kexecptr)(s32 cycles);  // M68K->Exec or M68KExecBP
 static s32 savedcycles;  // Cycles left over from the last M68KExec() call
@@ -3281,14 +3518,84 @@ ScspChangeSoundCore (int coreid)
 void
 ScspSetFrameAccurate (int on)
 {
+   if (!on)
+      ScspSetThreaded (0);
    scspframeaccurate = (on != 0);
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
+void
+ScspSetThreaded (int on)
+{
+  if (on && !scspframeaccurate)
+    {
+      SCSPLOG ("WARNING: threaded sound generation needs frame-accurate audio\n");
+      on = 0;
+    }
+
+  if ((on != 0) == scspthread.running)
+    return;
+
+  if (on)
+    {
+      scspthread.quit = 0;
+      scspthread.busy = 0;
+      scspthread.ram = (u8 *)malloc (SCSP_RAM_SIZE);
+      scspthread.start = YabSemCreate (0);
+      scspthread.done = YabSemCreate (0);
+      if (scspthread.ram == NULL ||
+          scspthread.start == NULL || scspthread.done == NULL ||
+          YabThreadStart (YAB_THREAD_SCSP, ScspThread, NULL) != 0)
+        {
+          if (scspthread.start)
+            YabSemFree (scspthread.start);
+          if (scspthread.done)
+            YabSemFree (scspthread.done);
+          scspthread.start = scspthread.done = NULL;
+          free (scspthread.ram);
+          scspthread.ram = NULL;
+          return;
+        }
+
+      memcpy (scspthread.ram, scsp.scsp_ram, SCSP_RAM_SIZE);
+      ScspSetSlotRam (scspthread.ram);
+      scspthread.running = 1;
+      scsp_frame_time = 0;
+      scsp_queue_writes = 1;
+    }
+  else
+    {
+      ScspThreadSync ();
+      scsp_queue_writes = 0;
+
+      scspthread.quit = 1;
+      YabSemPost (scspthread.start);
+      YabThreadWait (YAB_THREAD_SCSP);
+      scspthread.running = 0;
+
+      YabSemFree (scspthread.start);
+      YabSemFree (scspthread.done);
+      scspthread.start = scspthread.done = NULL;
+
+      ScspSetSlotRam (scsp.scsp_ram);
+      free (scspthread.ram);
+      scspthread.ram = NULL;
+
+      free (scspthread.queue.write);
+      memset (&scspthread.queue, 0, sizeof(scspthread.queue));
+      free (scsp_write_queue.write);
+      memset (&scsp_write_queue, 0, sizeof(scsp_write_queue));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void
 ScspDeInit (void)
 {
+  ScspSetThreaded (0);
+
   if (scspchannel[0].data32)
     free(scspchannel[0].data32);
   scspchannel[0].data32 = NULL;
@@ -3331,6 +3638,7 @@ M68KStop (void)
 void
 ScspReset (void)
 {
+  ScspThreadSync ();
   scsp_reset();
 }
 
@@ -3339,6 +3647,8 @@ ScspReset (void)
 int
 ScspChangeVideoFormat (int type)
 {
+  ScspThreadSync ();
+
   scspsoundlen = 44100 / (type ? 50 : 60);
   scsplines = type ? 313 : 263;
   scspsoundbufsize = scspsoundlen * scspsoundbufs;
@@ -3501,6 +3811,7 @@ ScspExec ()
   ScspInternalVars->scsptiming2 +=
     ((scspsoundlen << 16) + scsplines / 2) / scsplines;
   scsp_update_timer (ScspInternalVars->scsptiming2 >> 16); // Pass integer part
+  scsp_frame_time += ScspInternalVars->scsptiming2 >> 16;
   ScspInternalVars->scsptiming2 &= 0xFFFF; // Keep fractional part
   ScspInternalVars->scsptiming1++;
 
@@ -3513,6 +3824,10 @@ ScspExec ()
 
       if (scspframeaccurate)
         {
+          // Pick up the previous frame from the sound thread first
+          if (scspthread.running)
+            ScspThreadCollect ();
+
           // Update sound buffers
           if (scspsoundgenpos + scspsoundlen > scspsoundbufsize)
             scspsoundgenpos = 0;
@@ -3530,10 +3845,16 @@ ScspExec ()
           bufR = (s32 *)&scspchannel[1].data32[scspsoundgenpos];
           memset (bufL, 0, sizeof(u32) * scspsoundlen);
           memset (bufR, 0, sizeof(u32) * scspsoundlen);
-          scsp_update (bufL, bufR, scspsoundlen);
+          if (scspthread.running)
+            ScspThreadGenerate (bufL, bufR, scspsoundlen);
+          else
+            {
+              scsp_update (bufL, bufR, scspsoundlen);
+              scspsoundoutleft += scspsoundlen;
+            }
           scspsoundgenpos += scspsoundlen;
-          scspsoundoutleft += scspsoundlen;
         }
+      scsp_frame_time = 0;
     }
 
   if (scspframeaccurate)
@@ -3541,7 +3862,9 @@ ScspExec ()
       while (scspsoundoutleft > 0 &&
              (audiosize = SNDCore->GetAudioSpace ()) > 0)
         {
-          s32 outstart = (s32)scspsoundgenpos - (s32)scspsoundoutleft;
+          // Skip the frame still being generated on the sound thread
+          s32 outstart = (s32)scspsoundgenpos - (s32)scspsoundoutleft -
+                         (scspthread.busy ? (s32)scspthread.len : 0);
 
           if (outstart < 0)
             outstart += scspsoundbufsize;
@@ -3585,7 +3908,9 @@ ScspExec ()
         }
     }  // if (scspframeaccurate)
 
-  scsp_update_monitor ();
+  // With the sound thread, this is updated when its frame is collected
+  if (!scspthread.running)
+    scsp_update_monitor ();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -3780,6 +4105,8 @@ SoundSaveState (FILE *fp)
   u8 nextphase;
   IOCheck_struct check;
 
+  ScspThreadSync ();
+
   offset = StateWriteHeader (fp, "SCSP", 2);
 
   // Save 68k registers first
@@ -3899,6 +4226,10 @@ SoundLoadState (FILE *fp, int version, int size)
   u8 nextphase;
   IOCheck_struct check;
 
+  // Slot writes made while loading are applied right away
+  ScspThreadSync ();
+  scsp_queue_writes = 0;
+
   // Read 68k registers first
   yread (&check, (void *)&IsM68KRunning, 1, 1, fp);
 
@@ -3924,6 +4255,7 @@ SoundLoadState (FILE *fp, int version, int size)
 
   // Lastly, sound ram
   yread (&check, (void *)SoundRam, 0x80000, 1, fp);
+  M68K->WriteNotify (0, 0x80000);
 
   if (version > 1)
     {
@@ -3995,7 +4327,7 @@ SoundLoadState (FILE *fp, int version, int size)
           // Rebuild the buf8/buf16 variables
           if (scsp.slot[i].pcm8b)
             {
-              scsp.slot[i].buf8 = (s8*)&(scsp.scsp_ram[scsp.slot[i].sa]);
+              scsp.slot[i].buf8 = (s8*)&(scsp.slot_ram[scsp.slot[i].sa]);
               if ((scsp.slot[i].sa + (scsp.slot[i].lea >> SCSP_FREQ_LB)) >
                   SCSP_RAM_MASK)
                 scsp.slot[i].lea = (SCSP_RAM_MASK - scsp.slot[i].sa) <<
@@ -4003,7 +4335,7 @@ SoundLoadState (FILE *fp, int version, int size)
             }
           else
             {
-              scsp.slot[i].buf16 = (s16*)&(scsp.scsp_ram[scsp.slot[i].sa & ~1]);
+              scsp.slot[i].buf16 = (s16*)&(scsp.slot_ram[scsp.slot[i].sa & ~1]);
               if ((scsp.slot[i].sa + (scsp.slot[i].lea >> (SCSP_FREQ_LB - 1))) >
                   SCSP_RAM_MASK)
                 scsp.slot[i].lea = (SCSP_RAM_MASK - scsp.slot[i].sa) <<
@@ -4049,6 +4381,8 @@ SoundLoadState (FILE *fp, int version, int size)
       yread (&check, (void *)scsp.stack, 4, 32 * 2, fp);
     }
 
+  scsp_queue_writes = scspthread.running;
+
   return size;
 }
 
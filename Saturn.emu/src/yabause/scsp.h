@@ -90,6 +90,7 @@ void FASTCALL SoundRamWriteLong(u32 addr, u32 val);
 int ScspInit(int coreid);
 int ScspChangeSoundCore(int coreid);
 void ScspSetFrameAccurate(int on);
+void ScspSetThreaded(int on);
 void ScspDeInit(void);
 void M68KStart(void);
 void M68KStop(void);
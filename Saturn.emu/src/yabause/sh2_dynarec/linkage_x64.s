@@ -101,7 +101,7 @@ newline:
 	sub	%edx, %ebx  /* sh2cycles(full line) - decilinecycles*9 */
 	mov	%rax, CurrentSH2
 	mov	%ebx, -52(%rbp) /* sh2cycles */
-	cmp	$0, (%rax, %rcx)
+	cmpl	$0, (%rax, %rcx)
 	jne	master_handle_interrupts
 	mov	master_cc, %esi
 	sub	%ebx, %esi
@@ -136,7 +136,7 @@ slave_entry:
 	mov	SSH2, %rax
 	mov	NumberOfInterruptsOffset, %ecx
 	mov	%rax, CurrentSH2
-	cmp	$0, (%rax, %rcx)
+	cmpl	$0, (%rax, %rcx)
 	jne	slave_handle_interrupts
 	mov	slave_cc, %esi
 	sub	%ebx, %esi
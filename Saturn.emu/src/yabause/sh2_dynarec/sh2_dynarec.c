@@ -5231,19 +5231,58 @@ void disassemble_inst(int i)
     }
 }
 
+#ifdef __x86_64__
+extern char _end[];
+#endif
+
+#ifndef __arm__
+static int code_cache_mapped=0;
+#endif
+
+// Checks the host can run generated code and reserves the code cache,
+// returns non-zero if the interpreter should be used instead
+static int sh2_dynarec_map_code_cache()
+{
+  #ifdef __x86_64__
+  // Generated code and linkage_x64.s address globals and call C functions
+  // with 32-bit displacements, only possible in a non-PIE executable
+  if((pointer)_end>=0x80000000||(pointer)MappedMemoryReadLong>=0x80000000) {
+    printf("SH2 dynarec: executable is above 2GB (%p), build without PIE\n",(void *)_end);
+    return -1;
+  }
+  #endif
+  #ifdef __arm__
+  mprotect((void *)BASE_ADDR, 1<<TARGET_SIZE_2, PROT_READ | PROT_WRITE | PROT_EXEC);
+  #else
+  if(!code_cache_mapped) {
+    // Never replace an existing mapping (heap, sanitizer shadow, etc.)
+    #ifdef MAP_FIXED_NOREPLACE
+    int flags=MAP_FIXED_NOREPLACE | MAP_PRIVATE | MAP_ANONYMOUS;
+    #else
+    int flags=MAP_PRIVATE | MAP_ANONYMOUS;
+    #endif
+    void *addr=mmap ((void *)BASE_ADDR, 1<<TARGET_SIZE_2,
+                     PROT_READ | PROT_WRITE | PROT_EXEC, flags, -1, 0);
+    if(addr==MAP_FAILED) {
+      printf("SH2 dynarec: mmap() of code cache failed\n");
+      return -1;
+    }
+    if(addr!=(void *)BASE_ADDR) {
+      printf("SH2 dynarec: code cache address %p in use\n",(void *)BASE_ADDR);
+      munmap(addr, 1<<TARGET_SIZE_2);
+      return -1;
+    }
+    code_cache_mapped=1;
+  }
+  #endif
+  return 0;
+}
+
 void sh2_dynarec_init()
 {
   int n;
   //printf("Init new dynarec\n");
   out=(u8 *)BASE_ADDR;
-  #ifdef __arm__
-  mprotect(out, 1<<TARGET_SIZE_2, PROT_READ | PROT_WRITE | PROT_EXEC);
-  #else
-  if (mmap (out, 1<<TARGET_SIZE_2,
-            PROT_READ | PROT_WRITE | PROT_EXEC,
-            MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS,
-            -1, 0) == MAP_FAILED) {printf("mmap() failed\n");}
-  #endif
   //for(n=0x80000;n<0x80800;n++)
   //  invalid_code[n]=1;
   for(n=0;n<131072;n++)
@@ -5259,10 +5298,13 @@ void sh2_dynarec_init()
   expirep=16384; // Expiry pointer, +2 blocks
   literalcount=0;
   stop_after_jal=0;
+  // Unused N64 RDRAM region, overlaps the address sanitizer shadow on x86_64
+  #ifndef __x86_64__
   if (mmap ((void *)0x80000000, 4194304,
             PROT_READ | PROT_WRITE,
             MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS,
             -1, 0) == MAP_FAILED) {printf("mmap() failed\n");}
+  #endif
 
   // This has to be done after BiosRom etc are allocated
   for(n=0;n<1048576;n++) {
@@ -5321,9 +5363,14 @@ void sh2_dynarec_cleanup()
 {
   int n;
   #ifndef __arm__
-  if (munmap ((void *)BASE_ADDR, 1<<TARGET_SIZE_2) < 0) {printf("munmap() failed\n");}
+  if(code_cache_mapped) {
+    if (munmap ((void *)BASE_ADDR, 1<<TARGET_SIZE_2) < 0) {printf("munmap() failed\n");}
+    code_cache_mapped=0;
+  }
   #endif
+  #ifndef __x86_64__
   munmap ((void *)0x80000000, 4194304);
+  #endif
   for(n=0;n<2048;n++) ll_clear(jump_in+n);
   for(n=0;n<2048;n++) ll_clear(jump_out+n);
   for(n=0;n<2048;n++) ll_clear(jump_dirty+n);
@@ -8225,7 +8272,7 @@ int SH2InterpreterGetInterrupts(SH2_struct *context,
 void SH2InterpreterSetInterrupts(SH2_struct *context, int num_interrupts,
                                  const interrupt_struct interrupts[MAX_INTERRUPTS]);
 
-int SH2DynarecInit(void) {return 0;}
+int SH2DynarecInit(void) {return sh2_dynarec_map_code_cache();}
 
 void SH2DynarecDeInit() {
   sh2_dynarec_cleanup();
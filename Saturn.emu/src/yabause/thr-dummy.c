@@ -35,4 +35,12 @@ void YabThreadRemoteSleep(unsigned int id) {}
 
 void YabThreadWake(unsigned int id) {}
 
+YabSem *YabSemCreate(int value) { return NULL; }
+
+void YabSemFree(YabSem *sem) {}
+
+void YabSemPost(YabSem *sem) {}
+
+void YabSemWait(YabSem *sem) {}
+
 //////////////////////////////////////////////////////////////////////////////
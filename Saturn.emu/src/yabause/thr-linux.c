@@ -23,6 +23,8 @@
 
 #include <errno.h>
 #include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
 #include <signal.h>
 #include <unistd.h>
 
@@ -104,3 +106,52 @@ void YabThreadWake(unsigned int id)
 }
 
 //////////////////////////////////////////////////////////////////////////////
+
+struct YabSem_struct
+{
+   sem_t sem;
+};
+
+YabSem *YabSemCreate(int value)
+{
+   YabSem *sem = (YabSem *)malloc(sizeof(YabSem));
+   if (!sem)
+      return NULL;
+
+   if (sem_init(&sem->sem, 0, value) != 0)
+   {
+      perror("sem_init");
+      free(sem);
+      return NULL;
+   }
+
+   return sem;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void YabSemFree(YabSem *sem)
+{
+   if (!sem)
+      return;
+
+   sem_destroy(&sem->sem);
+   free(sem);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void YabSemPost(YabSem *sem)
+{
+   sem_post(&sem->sem);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void YabSemWait(YabSem *sem)
+{
+   while (sem_wait(&sem->sem) != 0 && errno == EINTR)
+      ;
+}
+
+//////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,10 @@ enum {
    YAB_THREAD_NETLINKLISTENER,
    YAB_THREAD_NETLINKCONNECT,
    YAB_THREAD_NETLINKCLIENT,
+   YAB_THREAD_VIDSOFT_LAYER0,
+   YAB_THREAD_VIDSOFT_LAYER1,
+   YAB_THREAD_VIDSOFT_LAYER2,
+   YAB_THREAD_VIDSOFT_LAYER3,
    YAB_NUM_THREADS      // Total number of subthreads
 };
 
@@ -65,6 +69,20 @@ void YabThreadRemoteSleep(unsigned int id);
 // YabThreadWake:  Wake up the given thread if it is asleep.
 void YabThreadWake(unsigned int id);
 
+// YabSemCreate:  Create a counting semaphore with the given initial value.
+// Returns NULL on error.
+typedef struct YabSem_struct YabSem;
+YabSem *YabSemCreate(int value);
+
+// YabSemFree:  Destroy a semaphore, no thread may be waiting on it.
+void YabSemFree(YabSem *sem);
+
+// YabSemPost:  Increment the semaphore, waking one waiting thread.
+void YabSemPost(YabSem *sem);
+
+// YabSemWait:  Wait until the semaphore is non-zero, then decrement it.
+void YabSemWait(YabSem *sem);
+
 ///////////////////////////////////////////////////////////////////////////
 
 #endif  // THREADS_H
@@ -1314,6 +1314,7 @@ int VIDDummyVdp2Reset(void);
 void VIDDummyVdp2DrawStart(void);
 void VIDDummyVdp2DrawEnd(void);
 void VIDDummyVdp2DrawScreens(void);
+void VIDDummyVdp2DrawScreensWait(void);
 void VIDDummyGetGlSize(int *width, int *height);
 
 
@@ -1340,6 +1341,7 @@ VIDDummyVdp2Reset,
 VIDDummyVdp2DrawStart,
 VIDDummyVdp2DrawEnd,
 VIDDummyVdp2DrawScreens,
+VIDDummyVdp2DrawScreensWait,
 VIDDummyGetGlSize
 };
 
@@ -1469,6 +1471,12 @@ void VIDDummyVdp2DrawScreens(void)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void VIDDummyVdp2DrawScreensWait(void)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void VIDDummyGetGlSize(int *width, int *height)
 {
    *width = 0;
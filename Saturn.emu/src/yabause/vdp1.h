@@ -52,6 +52,8 @@ typedef struct
    void (*Vdp2DrawStart)(void);
    void (*Vdp2DrawEnd)(void);
    void (*Vdp2DrawScreens)(void);
+   // waits for drawing started by Vdp2DrawScreens to finish
+   void (*Vdp2DrawScreensWait)(void);
    void (*GetGlSize)(int *width, int *height);
 } VideoInterface_struct;
 
@@ -346,8 +346,11 @@ void Vdp2VBlankOUT(void) {
    VIDCore->Vdp2DrawStart();
 
    if (Vdp2Regs->TVMD & 0x8000) {
+      // the video core may still be drawing VDP2 screens while VDP1 draws,
+      // both must be done before the CPUs can change video memory again
       VIDCore->Vdp2DrawScreens();
       if (Vdp1Regs->PTMR == 2) Vdp1Draw();
+      VIDCore->Vdp2DrawScreensWait();
    }
    else
       if (Vdp1Regs->PTMR == 2) Vdp1NoDraw();
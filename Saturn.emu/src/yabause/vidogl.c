@@ -76,6 +76,7 @@ int VIDOGLVdp2Reset(void);
 void VIDOGLVdp2DrawStart(void);
 void VIDOGLVdp2DrawEnd(void);
 void VIDOGLVdp2DrawScreens(void);
+void VIDOGLVdp2DrawScreensWait(void);
 void VIDOGLVdp2SetResolution(u16 TVMD);
 void YglGetGlSize(int *width, int *height);
 
@@ -102,6 +103,7 @@ VIDOGLVdp2Reset,
 VIDOGLVdp2DrawStart,
 VIDOGLVdp2DrawEnd,
 VIDOGLVdp2DrawScreens,
+VIDOGLVdp2DrawScreensWait,
 YglGetGlSize
 };
 
@@ -3927,6 +3929,12 @@ void VIDOGLVdp2DrawScreens(void)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void VIDOGLVdp2DrawScreensWait(void)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void VIDOGLVdp2SetResolution(u16 TVMD)
 {
    int width=0, height=0;
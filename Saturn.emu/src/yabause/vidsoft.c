@@ -25,6 +25,8 @@
 #include "debug.h"
 #include "vdp2.h"
 #include "titan/titan.h"
+#include "threads.h"
+#include "yabause.h"
 
 #ifdef HAVE_LIBGL
 #define USE_OPENGL
@@ -95,6 +97,7 @@ int VIDSoftVdp2Reset(void);
 void VIDSoftVdp2DrawStart(void);
 void VIDSoftVdp2DrawEnd(void);
 void VIDSoftVdp2DrawScreens(void);
+void VIDSoftVdp2DrawScreensWait(void);
 void VIDSoftVdp2SetResolution(u16 TVMD);
 void FASTCALL VIDSoftVdp2SetPriorityNBG0(int priority);
 void FASTCALL VIDSoftVdp2SetPriorityNBG1(int priority);
@@ -132,6 +135,7 @@ VIDSoftVdp2Reset,
 VIDSoftVdp2DrawStart,
 VIDSoftVdp2DrawEnd,
 VIDSoftVdp2DrawScreens,
+VIDSoftVdp2DrawScreensWait,
 VIDSoftGetGlSize,
 };
 
@@ -162,6 +166,27 @@ static int outputheight;
 #endif
 static int resxratio;
 static int resyratio;
+static int mosaic_table[16][1024];
+
+/* Screens of different priorities draw into separate Titan framebuffers,
+   so each priority can be drawn on its own thread. Screens sharing a
+   priority blend into the same framebuffer and stay on one thread in
+   their usual order. A screen in special priority mode 1 picks between
+   priorities 2n and 2n+1 per tile, so then both priorities go on one
+   thread. */
+#define VIDSOFT_NUM_LAYER_THREADS 4
+#define VIDSOFT_NUM_LAYERS 5
+
+static struct
+{
+   int numthreads;
+   volatile int quit;
+   YabSem *start[VIDSOFT_NUM_LAYER_THREADS];
+   YabSem *done[VIDSOFT_NUM_LAYER_THREADS];
+   int layers[VIDSOFT_NUM_LAYER_THREADS][VIDSOFT_NUM_LAYERS];
+   int numlayers[VIDSOFT_NUM_LAYER_THREADS];
+   int busy;
+} vidsoft_threads;
 
 typedef struct { s16 x; s16 y; } vdp1vertex;
 
@@ -667,22 +692,8 @@ static void FASTCALL Vdp2DrawScroll(vdp2draw_struct *info)
    ReadLineWindowData(&info->islinewindow, info->wctl, &linewnd0addr, &linewnd1addr);
    /* color calculation window: in => no color calc, out => color calc */
    ReadWindowData(Vdp2Regs->WCTLD >> 8, colorcalcwindow);
-   {
-	   static int tables_initialized = 0;
-	   static int mosaic_table[16][1024];
-	   if(!tables_initialized)
-	   {
-		   tables_initialized = 1;
-			for(i=0;i<16;i++)
-			{
-				int m = i+1;
-				for(j=0;j<1024;j++)
-					mosaic_table[i][j] = j/m*m;
-			}
-	   }
-	   mosaic_x = mosaic_table[info->mosaicxmask-1];
-	   mosaic_y = mosaic_table[info->mosaicymask-1];
-   }
+   mosaic_x = mosaic_table[info->mosaicxmask-1];
+   mosaic_y = mosaic_table[info->mosaicymask-1];
 
    for (j = 0; j < vdp2height; j++)
    {
@@ -1692,11 +1703,179 @@ static void LoadLineParamsSprite(vdp2draw_struct * info, int line)
 
 //////////////////////////////////////////////////////////////////////////////
 
+// Screens in the order they're drawn within a priority
+static void (*const Vdp2DrawLayer[VIDSOFT_NUM_LAYERS])(void) =
+{
+   Vdp2DrawNBG3, Vdp2DrawNBG2, Vdp2DrawNBG1, Vdp2DrawNBG0, Vdp2DrawRBG0
+};
+
+static void VidsoftLayerThread(void *arg)
+{
+   int id = (int)(pointer)arg;
+
+   for (;;)
+   {
+      int i;
+
+      YabSemWait(vidsoft_threads.start[id]);
+      if (vidsoft_threads.quit)
+         break;
+
+      for (i = 0; i < vidsoft_threads.numlayers[id]; i++)
+         Vdp2DrawLayer[vidsoft_threads.layers[id][i]]();
+
+      YabSemPost(vidsoft_threads.done[id]);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void VidsoftStopLayerThreads(void)
+{
+   int i;
+
+   vidsoft_threads.quit = 1;
+   for (i = 0; i < vidsoft_threads.numthreads; i++)
+   {
+      YabSemPost(vidsoft_threads.start[i]);
+      YabThreadWait(YAB_THREAD_VIDSOFT_LAYER0 + i);
+   }
+
+   for (i = 0; i < VIDSOFT_NUM_LAYER_THREADS; i++)
+   {
+      YabSemFree(vidsoft_threads.start[i]);
+      YabSemFree(vidsoft_threads.done[i]);
+      vidsoft_threads.start[i] = vidsoft_threads.done[i] = NULL;
+   }
+
+   vidsoft_threads.numthreads = 0;
+   vidsoft_threads.busy = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void VidsoftStartLayerThreads(void)
+{
+   int i;
+
+   if (vidsoft_threads.numthreads || !yabsys.UseThreads)
+      return;
+
+   vidsoft_threads.quit = 0;
+   for (i = 0; i < VIDSOFT_NUM_LAYER_THREADS; i++)
+   {
+      if ((vidsoft_threads.start[i] = YabSemCreate(0)) == NULL ||
+          (vidsoft_threads.done[i] = YabSemCreate(0)) == NULL ||
+          YabThreadStart(YAB_THREAD_VIDSOFT_LAYER0 + i, VidsoftLayerThread, (void *)(pointer)i) != 0)
+      {
+         // draw everything on the calling thread instead
+         VidsoftStopLayerThreads();
+         return;
+      }
+      vidsoft_threads.numthreads++;
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Returns true if the screen's SFPRMD field selects per tile priority on any line
+static int VidsoftUsesTilePriority(int shift)
+{
+   int line;
+
+   if (((Vdp2Regs->SFPRMD >> shift) & 0x3) == 1)
+      return 1;
+
+   for (line = 0; line < vdp2height; line++)
+   {
+      Vdp2 *regs = Vdp2RestoreRegs(line);
+
+      if (regs && ((regs->SFPRMD >> shift) & 0x3) == 1)
+         return 1;
+   }
+
+   return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void VidsoftStartLayerDraw(void)
+{
+   static const int sfprmdshift[VIDSOFT_NUM_LAYERS] = { 6, 4, 2, 0, 8 };
+   int priorities[VIDSOFT_NUM_LAYERS] = { nbg3priority, nbg2priority, nbg1priority, nbg0priority, rbg0priority };
+   int pairshared[4] = { 0 };
+   int linesharedhigh = 0, linesharedlow = 0;
+   int i, layer, thread = 0, used = 0;
+
+   for (i = 0; i < vidsoft_threads.numthreads; i++)
+      vidsoft_threads.numlayers[i] = 0;
+
+   for (layer = 0; layer < VIDSOFT_NUM_LAYERS; layer++)
+   {
+      if (priorities[layer] > 0 && VidsoftUsesTilePriority(sfprmdshift[layer]))
+         pairshared[priorities[layer] >> 1] = 1;
+   }
+
+   // RBG0 and RBG1 can both write their line colors to the same line screen
+   // while drawing, so draw every priority between them on one thread
+   if ((Vdp2Regs->BGON & 0x20) && (Vdp2Regs->LNCLEN & 0x11) == 0x11 &&
+       nbg0priority > 0 && rbg0priority > 0)
+   {
+      linesharedhigh = nbg0priority > rbg0priority ? nbg0priority : rbg0priority;
+      linesharedlow = nbg0priority > rbg0priority ? rbg0priority : nbg0priority;
+   }
+
+   for (i = 7; i > 0; i--)
+   {
+      for (layer = 0; layer < VIDSOFT_NUM_LAYERS; layer++)
+      {
+         if (priorities[layer] != i)
+            continue;
+         vidsoft_threads.layers[thread][vidsoft_threads.numlayers[thread]++] = layer;
+         used = 1;
+      }
+
+      // a shared pair or line screen span moves on only after its lower priority
+      if (used && !((i & 1) && pairshared[i >> 1]) &&
+          !(i <= linesharedhigh && i > linesharedlow))
+      {
+         thread = (thread + 1) % vidsoft_threads.numthreads;
+         used = 0;
+      }
+   }
+
+   for (i = 0; i < vidsoft_threads.numthreads; i++)
+   {
+      if (!vidsoft_threads.numlayers[i])
+         continue;
+      vidsoft_threads.busy |= 1 << i;
+      YabSemPost(vidsoft_threads.start[i]);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void InitMosaicTable(void)
+{
+   int i, j;
+
+   for (i = 0; i < 16; i++)
+   {
+      int m = i + 1;
+      for (j = 0; j < 1024; j++)
+         mosaic_table[i][j] = j / m * m;
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 int VIDSoftInit(void)
 {
    if (TitanInit() == -1)
       return -1;
 
+   InitMosaicTable();
+
    if ((dispbuffer = (pixel_t *)memalign(8, sizeof(pixel_t) * 704 * 512)) == NULL)
       return -1;
 
@@ -1727,6 +1906,8 @@ int VIDSoftInit(void)
    outputheight = 224;
 #endif
 
+   VidsoftStartLayerThreads();
+
    return 0;
 }
 
@@ -1734,6 +1915,9 @@ int VIDSoftInit(void)
 
 void VIDSoftDeInit(void)
 {
+   VIDSoftVdp2DrawScreensWait();
+   VidsoftStopLayerThreads();
+
    if (dispbuffer)
    {
       free(dispbuffer);
@@ -3112,6 +3296,13 @@ void VIDSoftVdp2DrawScreens(void)
    VIDSoftVdp2SetPriorityNBG3((Vdp2Regs->PRINB >> 8) & 0x7);
    VIDSoftVdp2SetPriorityRBG0(Vdp2Regs->PRIR & 0x7);
 
+   if (vidsoft_threads.numthreads)
+   {
+      // finished in VIDSoftVdp2DrawScreensWait()
+      VidsoftStartLayerDraw();
+      return;
+   }
+
    for (i = 7; i > 0; i--)
    {   
       if (nbg3priority == i)
@@ -3129,6 +3320,20 @@ void VIDSoftVdp2DrawScreens(void)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void VIDSoftVdp2DrawScreensWait(void)
+{
+   int i;
+
+   for (i = 0; i < vidsoft_threads.numthreads; i++)
+   {
+      if (vidsoft_threads.busy & (1 << i))
+         YabSemWait(vidsoft_threads.done[i]);
+   }
+   vidsoft_threads.busy = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void VIDSoftVdp2DrawScreen(int screen)
 {
    VIDSoftVdp2SetResolution(Vdp2Regs->TVMD);
@@ -124,6 +124,29 @@ void Snes9xSystem::loadState(EmuApp &, IG::CStringView path)
 		return throwFileReadError();
 }
 
+#ifndef SNES9X_VERSION_1_4
+size_t Snes9xSystem::stateSize() { return S9xFreezeSize(); }
+
+size_t Snes9xSystem::writeState(std::span<uint8_t> buff)
+{
+	memStream stream{buff.data(), buff.size()};
+	S9xFreezeToStream(&stream);
+	return stream.pos();
+}
+
+void Snes9xSystem::readState(std::span<const uint8_t> buff)
+{
+	if(S9xUnfreezeGameMem(buff.data(), buff.size()) != SUCCESS)
+		throwFileReadError();
+	IPPU.RenderThisFrame = TRUE;
+}
+#else
+// 1.43 snapshots only support gzip file streams
+size_t Snes9xSystem::stateSize() { return 0; }
+size_t Snes9xSystem::writeState(std::span<uint8_t> buff) { throw std::runtime_error{"Memory save states not supported"}; }
+void Snes9xSystem::readState(std::span<const uint8_t> buff) { throw std::runtime_error{"Memory save states not supported"}; }
+#endif
+
 void Snes9xSystem::loadBackupMemory(EmuApp &app)
 {
 	if(!Memory.SRAMSize)
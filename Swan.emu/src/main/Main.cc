@@ -73,6 +73,10 @@ void WsSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t WsSystem::stateSize() { return stateSizeMDFN(); }
+size_t WsSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+void WsSystem::readState(std::span<const uint8_t> buff) { readStateMDFN(buff); }
+
 void WsSystem::loadBackupMemory(EmuApp &app)
 {
 	WSwan_MemoryLoadNV();
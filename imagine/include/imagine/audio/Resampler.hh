@@ -0,0 +1,56 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "Format.hh"
+#include <array>
+#include <vector>
+
+namespace IG::Audio
+{
+
+// Band-limited polyphase resampler using a windowed-sinc kernel. The input/output
+// ratio can change on every call, allowing it to be used for dynamic rate control.
+// Samples are processed as planar floats with a fixed tap count so the filter
+// loops vectorize.
+
+class Resampler
+{
+public:
+	static constexpr int taps = 16;
+	static constexpr int phases = 256;
+
+	void reset();
+	// Resamples srcFrames of src into dest, advancing step input frames per output frame.
+	// All input is consumed and the number of output frames written is returned,
+	// at most maxDestFrames(srcFrames, step).
+	size_t resample(void *dest, const void *src, size_t srcFrames, Format, double step);
+	static size_t maxDestFrames(size_t srcFrames, double step);
+
+protected:
+	using Kernel = std::array<float, taps>;
+
+	std::vector<Kernel> kernels;
+	std::array<std::vector<float>, 2> input;
+	double pos{};
+	double kernelStep{};
+	int8_t channels{};
+
+	void makeKernels(double step);
+	void setChannels(int8_t channels);
+};
+
+}
@@ -19,6 +19,8 @@
 
 #if defined __ANDROID__
 #include <imagine/base/eventloop/ALooperEventLoop.hh>
+#elif defined __linux__ && defined CONFIG_BASE_EPOLL
+#include <imagine/base/eventloop/EpollEventLoop.hh>
 #elif defined __linux__
 #include <imagine/base/eventloop/GlibEventLoop.hh>
 #define CONFIG_BASE_GLIB
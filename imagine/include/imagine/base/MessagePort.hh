@@ -20,8 +20,12 @@
 #include <imagine/thread/Semaphore.hh>
 #include <imagine/util/concepts.hh>
 #include <imagine/util/utility.h>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstring>
 #include <span>
+#include <thread>
 
 namespace IG
 {
@@ -211,6 +215,167 @@ protected:
 	Pipe pipe{Pipe::NullInit{}};
 };
 
+// Single-producer/single-consumer message queue in shared memory, avoiding the
+// syscalls of a pipe when both threads are running. The consumer spins for
+// spinCount checks of the queue before parking on a semaphore until the producer
+// sends the next message. Unlike PipeMessagePort, messages aren't dispatched
+// through an EventLoop and the consumer thread receives them with waitForMessages().
+
+template<class MsgType, size_t capacity = 8>
+class SPSCMessagePort
+{
+public:
+	static_assert(std::has_single_bit(capacity), "capacity must be a power of 2");
+
+	class Messages
+	{
+	public:
+		struct Sentinel {};
+
+		class Iterator
+		{
+		public:
+			constexpr Iterator(SPSCMessagePort &port): port{&port}
+			{
+				this->operator++();
+			}
+
+			Iterator operator++()
+			{
+				if(!port) [[unlikely]]
+					return *this;
+				if(!port->pop(msg))
+				{
+					// end of messages
+					port = nullptr;
+				}
+				return *this;
+			}
+
+			bool operator==(Sentinel) const
+			{
+				return !port;
+			}
+
+			const MsgType &operator*() const
+			{
+				return msg;
+			}
+
+		private:
+			SPSCMessagePort *port{};
+			MsgType msg{};
+		};
+
+		constexpr Messages(SPSCMessagePort &port): port{port} {}
+		auto begin() const { return Iterator{port}; }
+		auto end() const { return Sentinel{}; }
+
+	protected:
+		SPSCMessagePort &port;
+	};
+
+	SPSCMessagePort(int spinCount = 0):
+		spinCount{spinCount} {}
+
+	bool send(MsgType msg)
+	{
+		auto writeIdx = writeIdx_.load(std::memory_order_relaxed);
+		while(writeIdx - readIdx_.load(std::memory_order_acquire) == capacity) [[unlikely]]
+		{
+			// queue is full, wait for the consumer to catch up
+			std::this_thread::yield();
+		}
+		slots[writeIdx % capacity] = msg;
+		writeIdx_.store(writeIdx + 1, std::memory_order_seq_cst);
+		if(consumerParked.exchange(false, std::memory_order_seq_cst))
+			wakeSemaphore.release();
+		return true;
+	}
+
+	bool send(MsgType msg, bool awaitReply)
+	{
+		if(awaitReply)
+		{
+			std::binary_semaphore replySemaphore{0};
+			return send(msg, &replySemaphore);
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	bool send(ReplySemaphoreSettableMessage auto msg, std::binary_semaphore *semPtr)
+	{
+		if(semPtr)
+		{
+			msg.setReplySemaphore(semPtr);
+			send(msg);
+			semPtr->acquire();
+			return true;
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	// blocks the consumer thread until at least one message is available
+	Messages waitForMessages()
+	{
+		for(int i = 0; i < spinCount; i++)
+		{
+			if(hasMessages())
+				return {*this};
+		}
+		consumerParked.store(true, std::memory_order_seq_cst);
+		if(hasMessages())
+		{
+			// if the producer already cleared the flag, consume its wake-up
+			if(!consumerParked.exchange(false, std::memory_order_seq_cst))
+				wakeSemaphore.acquire();
+			return {*this};
+		}
+		wakeSemaphore.acquire();
+		return {*this};
+	}
+
+	Messages messages()
+	{
+		return {*this};
+	}
+
+	bool hasMessages() const
+	{
+		return writeIdx_.load(std::memory_order_seq_cst) != readIdx_.load(std::memory_order_relaxed);
+	}
+
+	void clear()
+	{
+		readIdx_.store(writeIdx_.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+protected:
+	std::array<MsgType, capacity> slots{};
+	// keep the indices on separate cache lines since each is written by a different thread
+	alignas(64) std::atomic<size_t> writeIdx_{};
+	alignas(64) std::atomic<size_t> readIdx_{};
+	std::atomic_bool consumerParked{};
+	std::binary_semaphore wakeSemaphore{0};
+	int spinCount{};
+
+	bool pop(MsgType &msg)
+	{
+		auto readIdx = readIdx_.load(std::memory_order_relaxed);
+		if(readIdx == writeIdx_.load(std::memory_order_acquire))
+			return false;
+		msg = slots[readIdx % capacity];
+		readIdx_.store(readIdx + 1, std::memory_order_release);
+		return true;
+	}
+};
+
 template<class MsgType>
 using MessagePort = PipeMessagePort<MsgType>;
 
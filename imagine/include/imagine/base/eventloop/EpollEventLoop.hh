@@ -0,0 +1,83 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/eventLoopDefs.hh>
+#include <imagine/util/used.hh>
+#include <imagine/util/memory/UniqueFileDescriptor.hh>
+#include <sys/epoll.h>
+#include <memory>
+#include <span>
+
+namespace IG
+{
+
+static const int POLLEV_IN = EPOLLIN, POLLEV_OUT = EPOLLOUT, POLLEV_ERR = EPOLLERR, POLLEV_HUP = EPOLLHUP;
+
+struct EpollEventLoopData
+{
+	UniqueFileDescriptor epollFd{};
+	UniqueFileDescriptor wakeFd{};
+	// events returned by the current epoll_wait() call, cleared by sources detached during dispatch
+	std::span<epoll_event> dispatchingEvents{};
+	// runs before each epoll_wait() call, for sources that buffer events outside their fd
+	DelegateFunc<void()> beforeWait{};
+};
+
+struct EpollFDEventSourceInfo
+{
+	PollEventDelegate callback{};
+	EpollEventLoopData *loop{};
+	int fd{-1};
+};
+
+class EpollFDEventSource
+{
+public:
+	constexpr EpollFDEventSource() = default;
+	EpollFDEventSource(MaybeUniqueFileDescriptor fd) : EpollFDEventSource{nullptr, std::move(fd)} {}
+	EpollFDEventSource(const char *debugLabel, MaybeUniqueFileDescriptor fd);
+	EpollFDEventSource(EpollFDEventSource &&o) noexcept;
+	EpollFDEventSource &operator=(EpollFDEventSource &&o) noexcept;
+	~EpollFDEventSource();
+
+protected:
+	IG_UseMemberIf(Config::DEBUG_BUILD, const char *, debugLabel){};
+	std::unique_ptr<EpollFDEventSourceInfo> info{};
+	MaybeUniqueFileDescriptor fd_{};
+
+	const char *label() const;
+	void deinit();
+};
+
+using FDEventSourceImpl = EpollFDEventSource;
+
+class EpollEventLoop
+{
+public:
+	constexpr EpollEventLoop() = default;
+	constexpr EpollEventLoop(EpollEventLoopData *data): data{data} {}
+	int nativeObject() const { return data ? (int)data->epollFd : -1; }
+	EpollEventLoopData *loopData() const { return data; }
+	void setBeforeWait(DelegateFunc<void()> del) { data->beforeWait = del; }
+
+protected:
+	EpollEventLoopData *data{};
+};
+
+using EventLoopImpl = EpollEventLoop;
+
+}
@@ -35,11 +35,33 @@ class ApplicationContext;
 namespace IG::Data
 {
 
+enum class PixmapFileFormat : uint8_t
+{
+	PNG,
+	BMP, // uncompressed, fastest to write
+};
+
+enum class PngFilter : uint8_t
+{
+	DEFAULT, NONE, SUB, UP, PAETH, ALL
+};
+
+struct PixmapWriteParams
+{
+	PixmapFileFormat format{PixmapFileFormat::PNG};
+	int8_t compressionLevel{-1}; // zlib level 0-9 or -1 for the default, ignored if the platform encoder doesn't support it
+	PngFilter filter{PngFilter::DEFAULT};
+
+	constexpr std::string_view fileExtension() const { return format == PixmapFileFormat::BMP ? ".bmp" : ".png"; }
+};
+
 class PixmapWriter final: public PixmapWriterImpl
 {
 public:
 	using PixmapWriterImpl::PixmapWriterImpl;
-	bool writeToFile(PixmapView, const char *path) const;
+	bool writeToFile(PixmapView, const char *path, PixmapWriteParams params = {}) const;
 };
 
+bool writeBMPFile(PixmapView, const char *path);
+
 }
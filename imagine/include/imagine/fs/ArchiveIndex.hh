@@ -0,0 +1,87 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/io/ArchiveIO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <list>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace IG
+{
+class IO;
+}
+
+namespace IG::FS
+{
+
+// Lists all entries of an archive in a single pass, then allows opening them in any order.
+// The reader's position is tracked so entries opened in archive order never cause a rewind,
+// and recently decompressed entries are kept in memory up to the given byte budget.
+// Entries too large for the cache are streamed straight from the archive instead,
+// and the returned IO must be handed back with close() before opening another entry.
+class ArchiveIndex
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		size_t size{};
+		uint32_t crc32{};
+		file_type type{};
+	};
+
+	static constexpr size_t defaultCacheCapacity = 64 * 1024 * 1024;
+
+	ArchiveIndex() = default;
+	ArchiveIndex(CStringView path, size_t cacheCapacity = defaultCacheCapacity);
+	explicit ArchiveIndex(IO, size_t cacheCapacity = defaultCacheCapacity);
+	std::span<const Entry> entries() const { return entries_; }
+	const Entry *find(std::string_view name) const;
+	const Entry *findCRC32(uint32_t crc) const;
+	IO open(const Entry &);
+	void close(IO);
+	void setCacheCapacity(size_t bytes);
+	size_t cacheCapacity() const { return cacheCapacity_; }
+	size_t cacheSize() const { return cacheSize_; }
+	void clearCache();
+	explicit operator bool() const { return reader.archive(); }
+
+protected:
+	struct CachedEntry
+	{
+		std::unique_ptr<uint8_t[]> data;
+		size_t size{};
+		size_t entryIdx{};
+	};
+
+	ArchiveEntry reader{};
+	std::vector<Entry> entries_{};
+	std::list<CachedEntry> cache{}; // most recently used first
+	size_t cacheCapacity_{};
+	size_t cacheSize_{};
+	size_t readerIdx{}; // entry whose header the reader last read
+	bool readerDataConsumed{};
+
+	void init();
+	bool seekReader(size_t idx);
+	void evictCache(size_t bytesNeeded);
+};
+
+}
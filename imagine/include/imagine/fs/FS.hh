@@ -71,6 +71,8 @@ bool access(IG::CStringView path, acc type);
 bool remove(IG::CStringView path);
 bool create_directory(IG::CStringView path);
 bool rename(IG::CStringView oldPath, IG::CStringView newPath);
+// sets the access & last write times to now
+bool touch(IG::CStringView path);
 
 PathString makeAppPathFromLaunchCommand(IG::CStringView launchPath);
 FileString basename(IG::CStringView path);
@@ -19,6 +19,8 @@
 #include <imagine/font/Font.hh>
 #include <imagine/gfx/Texture.hh>
 #include <imagine/util/container/VMemArray.hh>
+#include <memory>
+#include <vector>
 #include <system_error>
 
 namespace IG::Gfx
@@ -28,10 +30,22 @@ constexpr auto glyphSamplerConfig = SamplerConfigs::noMipClamp;
 
 struct GlyphEntry
 {
-	Texture glyph_{};
+	TextureSpan glyph_{};
 	GlyphMetrics metrics{};
 
-	constexpr const Texture &glyph() const { return glyph_; }
+	constexpr TextureSpan glyph() const { return glyph_; }
+};
+
+// Glyphs are shelf-packed into atlas textures, with each page only holding
+// glyphs from one 2048 character plane of the glyph table so freeing a plane
+// frees its pages
+
+struct GlyphAtlasPage
+{
+	Texture texture;
+	WP shelfPos{};
+	int shelfHeight{};
+	int plane{};
 };
 
 struct GlyphSetMetrics
@@ -62,14 +76,17 @@ public:
 private:
 	Font font;
 	VMemArray<GlyphEntry> glyphTable;
+	std::vector<std::unique_ptr<GlyphAtlasPage>> atlasPages;
 	FontSettings settings;
 	FontSize faceSize;
 	GlyphSetMetrics metrics_;
 	uint32_t usedGlyphTableBits{};
+	int atlasPageSize{};
 
 	void calcMetrics(Renderer &r);
 	void resetGlyphTable();
 	std::errc cacheChar(Renderer &r, int c, int tableIdx);
+	TextureSpan addToAtlas(Renderer &r, PixmapView, int plane);
 };
 
 }
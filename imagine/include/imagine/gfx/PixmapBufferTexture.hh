@@ -42,6 +42,9 @@ public:
 	ErrorCode setFormat(PixmapDesc desc, ColorSpace c = {}, TextureSamplerConfig samplerConf = {});
 	void write(PixmapView pixmap, uint32_t writeFlags = 0);
 	void writeAligned(PixmapView pixmap, int assumedDataAlignment, uint32_t writeFlags = 0);
+	// Writes the pixmap's rows starting at destRow, keeping the rest of the image,
+	// returns false without writing if the buffer type can only be written whole
+	bool writeRows(PixmapView pixmap, int destRow, uint32_t writeFlags = 0);
 	void clear();
 	LockedTextureBuffer lock(uint32_t bufferFlags = 0);
 	void unlock(LockedTextureBuffer lockBuff, uint32_t writeFlags = 0);
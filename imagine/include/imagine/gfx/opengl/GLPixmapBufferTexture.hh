@@ -41,6 +41,7 @@ public:
 
 	ErrorCode setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	void writeAligned(PixmapView pixmap, int assumeAlign, uint32_t writeFlags = 0);
+	bool writeRowsAligned(PixmapView pixmap, int destRow, int assumeAlign, uint32_t writeFlags = 0);
 	LockedTextureBuffer lock(uint32_t bufferFlags = 0);
 	void unlock(LockedTextureBuffer lockBuff, uint32_t writeFlags = 0);
 	bool isSingleBuffered() const { return bufferIdx == SINGLE_BUFFER_VALUE; }
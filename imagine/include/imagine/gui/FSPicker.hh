@@ -25,6 +25,7 @@
 #include <imagine/thread/WorkThread.hh>
 #include <imagine/util/DelegateFunc.hh>
 #include <imagine/util/string/CStringView.hh>
+#include <mutex>
 #include <vector>
 
 namespace IG::FS
@@ -85,6 +86,9 @@ protected:
 	OnChangePathDelegate onChangePath_{};
 	OnSelectPathDelegate onSelectPath_{};
 	std::vector<FileEntry> dir{};
+	std::vector<FileEntry> pendingDir{}; // entries from dirListThread not yet merged into dir
+	std::mutex pendingDirMutex;
+	FS::PathString dirCachePath{};
 	FS::RootedPath root{};
 	Gfx::Text msgText{};
 	CustomEvent dirListEvent{"FSPicker::dirListEvent", {}};
@@ -99,6 +103,9 @@ protected:
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
 	void listDirectory(CStringView path, ThreadStop &stop);
+	void addPendingEntries(std::vector<FileEntry> &);
+	void mergePendingEntries();
+	void selectEntry(size_t idx, const Input::Event &);
 	void setEmptyPath(std::string_view message);
 };
 
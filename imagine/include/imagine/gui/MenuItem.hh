@@ -110,7 +110,8 @@ public:
 	static constexpr uint32_t SELECTABLE_FLAG = bit(0);
 	static constexpr uint32_t ACTIVE_FLAG = bit(1);
 	static constexpr uint32_t HIGHLIGHT_FLAG = bit(2);
-	static constexpr uint32_t IMPL_FLAG_START = bit(3);
+	static constexpr uint32_t NEEDS_COMPILE_FLAG = bit(3);
+	static constexpr uint32_t IMPL_FLAG_START = bit(4);
 	static constexpr uint32_t USER_FLAG_START = bit(16);
 	static constexpr uint32_t DEFAULT_FLAGS = SELECTABLE_FLAG | ACTIVE_FLAG;
 	static constexpr Id DEFAULT_ID = static_cast<Id>(std::numeric_limits<IdInt>::min());
@@ -135,6 +136,8 @@ public:
 	constexpr void setActive(bool on) { flags_ = setOrClearBits(flags_, ACTIVE_FLAG, on); }
 	constexpr bool highlighted() const { return flags_ & HIGHLIGHT_FLAG; }
 	constexpr void setHighlighted(bool on) { flags_ = setOrClearBits(flags_, HIGHLIGHT_FLAG, on); }
+	constexpr bool needsCompile() const { return flags_ & NEEDS_COMPILE_FLAG; }
+	constexpr void setNeedsCompile(bool on) { flags_ = setOrClearBits(flags_, NEEDS_COMPILE_FLAG, on); }
 	constexpr Id id() const { return (Id)id_; }
 	constexpr void setId(IdInt id) { id_ = id; }
 
@@ -77,6 +77,8 @@ public:
 	void resetName(UTF16Convertible auto &&name) { nameStr = IG_forward(name); }
 	void resetName() { nameStr.clear(); }
 	void setItemsDelegate(ItemsDelegate items_ = [](const TableView &){ return 0; }) { items = items_; }
+	// Only compile items as they become visible, for tables with many items
+	void setLazyItemCompile(bool on) { lazyItemCompile = on; }
 
 protected:
 	ItemsDelegate items{};
@@ -90,6 +92,7 @@ protected:
 	bool onlyScrollIfNeeded = false;
 	bool selectedIsActivated = false;
 	bool hasFocus = true;
+	bool lazyItemCompile = false;
 
 	void setYCellSize(int s);
 	IG::WindowRect focusRect();
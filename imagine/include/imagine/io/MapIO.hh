@@ -36,6 +36,7 @@ public:
 
 	constexpr MapIO() = default;
 	MapIO(IOBuffer);
+	explicit MapIO(std::span<uint8_t> span): MapIO{IOBuffer{span}} {}
 	explicit MapIO(Readable auto &&io): MapIO{io.buffer(BufferMode::RELEASE)} {}
 	explicit MapIO(Readable auto &io): MapIO{io.buffer(BufferMode::DIRECT)} {}
 	ssize_t read(void *buff, size_t bytes);
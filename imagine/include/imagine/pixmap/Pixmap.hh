@@ -39,6 +39,13 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(ByteArray<3> p);
 uint32_t transformRGB888ToBGRX8888(ByteArray<3> p);
 
+// vectorized versions for converting runs of pixels
+void transformRGBA8888ToBGRA8888N(const uint32_t *src, size_t pixels, uint32_t *dest);
+void transformRGBX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest);
+void transformBGRX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest);
+void transformRGB565ToRGBX8888N(const uint16_t *src, size_t pixels, uint32_t *dest);
+void transformRGB565ToBGRX8888N(const uint16_t *src, size_t pixels, uint32_t *dest);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -307,6 +314,27 @@ public:
 		writeTransformed2<Src, Dest>(func, pixmap);
 	}
 
+	template <class Src, class Dest>
+	void writeTransformedN(auto &&func, auto pixmap) requires(dataIsMutable)
+	{
+		auto srcData = (const Src*)pixmap.data();
+		auto destData = (Dest*)data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			func(srcData, pixmap.w() * pixmap.h(), destData);
+		}
+		else
+		{
+			auto destPitchPixels = pitchPixels();
+			for(auto h : iotaCount(pixmap.h()))
+			{
+				func(srcData, pixmap.w(), destData);
+				srcData += pixmap.pitchPixels();
+				destData += destPitchPixels;
+			}
+		}
+	}
+
 protected:
 	PixData *data_{};
 	int pitch{}; // in bytes
@@ -371,12 +399,12 @@ protected:
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.template writeTransformedN<uint16_t, uint32_t>(transformRGB565ToRGBX8888N, src);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.template writeTransformedN<uint16_t, uint32_t>(transformRGB565ToBGRX8888N, src);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
@@ -401,17 +429,17 @@ protected:
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.template writeTransformedN<uint32_t, uint16_t>(transformRGBX8888ToRGB565N, src);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.template writeTransformedN<uint32_t, uint32_t>(transformRGBA8888ToBGRA8888N, src);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.template writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.template writeTransformedN<uint32_t, uint16_t>(transformBGRX8888ToRGB565N, src);
 	}
 };
 
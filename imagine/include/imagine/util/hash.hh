@@ -0,0 +1,48 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace IG
+{
+
+constexpr uint64_t hashSeed = 0xcbf29ce484222325;
+
+// Fast non-cryptographic hash for checking data is identical, using FNV-1a steps
+// on 64-bit words, pass the previous result as the seed to hash data in pieces
+inline uint64_t hashBytes(std::span<const unsigned char> data, uint64_t hash = hashSeed)
+{
+	constexpr uint64_t prime = 0x100000001b3;
+	auto bytes = data.data();
+	size_t size = data.size();
+	size_t i = 0;
+	for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, bytes + i, sizeof(word));
+		hash = (hash ^ word) * prime;
+	}
+	for(; i < size; i++)
+	{
+		hash = (hash ^ bytes[i]) * prime;
+	}
+	return hash;
+}
+
+}
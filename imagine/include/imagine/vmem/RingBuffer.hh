@@ -40,6 +40,7 @@ public:
 	SizeType writeUnchecked(const void *buff, SizeType size);
 	char *writeAddr() const;
 	void commitWrite(SizeType size);
+	void uncommitWrite(SizeType size);
 	SizeType read(void *buff, SizeType size);
 	char *readAddr() const;
 	void commitRead(SizeType size);
@@ -0,0 +1,187 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/Resampler.hh>
+#include <imagine/util/utility.h>
+#include <imagine/util/ranges.hh>
+#include <algorithm>
+#include <numbers>
+#include <cmath>
+
+namespace IG::Audio
+{
+
+// The kernel is centered between taps halfTaps - 1 and halfTaps, so each input vector keeps
+// the last historyFrames frames of the previous call to filter across call boundaries
+constexpr int halfTaps = Resampler::taps / 2;
+constexpr int historyFrames = Resampler::taps - 1;
+constexpr double cutoffScale = .9; // leave a transition band below Nyquist
+
+static double sinc(double x)
+{
+	if(x == 0.)
+		return 1.;
+	x *= std::numbers::pi;
+	return std::sin(x) / x;
+}
+
+static double blackman(double x)
+{
+	// x in the range [-halfTaps, halfTaps]
+	constexpr double pi = std::numbers::pi;
+	return .42 + .5 * std::cos(pi * x / halfTaps) + .08 * std::cos(2. * pi * x / halfTaps);
+}
+
+static double kernelStepForStep(double step)
+{
+	// only widen the anti-aliasing filter for downsampling, in 1/8 increments to avoid
+	// rebuilding the kernels on every small ratio change
+	return std::max(1., std::round(step * 8.) / 8.);
+}
+
+void Resampler::reset()
+{
+	for(auto &i : input)
+	{
+		i.assign(historyFrames, 0.f);
+	}
+	pos = halfTaps - 1;
+}
+
+void Resampler::setChannels(int8_t newChannels)
+{
+	assumeExpr(newChannels == 1 || newChannels == 2);
+	if(channels == newChannels)
+		return;
+	channels = newChannels;
+	reset();
+}
+
+void Resampler::makeKernels(double step)
+{
+	kernelStep = step;
+	kernels.resize(phases + 1);
+	const double cutoff = cutoffScale / step;
+	for(auto phase : iotaCount(phases + 1))
+	{
+		auto &kernel = kernels[phase];
+		double frac = (double)phase / phases;
+		double sum{};
+		std::array<double, taps> weights;
+		for(auto k : iotaCount(taps))
+		{
+			double x = (k - (halfTaps - 1)) - frac;
+			weights[k] = cutoff * sinc(cutoff * x) * blackman(x);
+			sum += weights[k];
+		}
+		// normalize each phase to unity gain so DC passes unchanged
+		for(auto k : iotaCount(taps))
+		{
+			kernel[k] = weights[k] / sum;
+		}
+	}
+}
+
+size_t Resampler::maxDestFrames(size_t srcFrames, double step)
+{
+	return std::ceil(srcFrames / step) + 1;
+}
+
+static void appendSamples(std::array<std::vector<float>, 2> &input, const void *src, size_t srcFrames, Format format)
+{
+	auto size = input[0].size();
+	for(auto c : iotaCount(format.channels))
+	{
+		input[c].resize(size + srcFrames);
+	}
+	if(format.sample.isFloat())
+	{
+		auto s = (const float*)src;
+		for(auto i : iotaCount(srcFrames))
+		{
+			for(auto c : iotaCount(format.channels))
+			{
+				input[c][size + i] = *s++;
+			}
+		}
+	}
+	else
+	{
+		auto s = (const int16_t*)src;
+		for(auto i : iotaCount(srcFrames))
+		{
+			for(auto c : iotaCount(format.channels))
+			{
+				input[c][size + i] = *s++ / 32768.f;
+			}
+		}
+	}
+}
+
+static float filter(const float * __restrict__ x, const float * __restrict__ k0,
+	const float * __restrict__ k1, float mix)
+{
+	float acc{};
+	for(int k = 0; k < Resampler::taps; k++)
+	{
+		acc += x[k] * (k0[k] + (k1[k] - k0[k]) * mix);
+	}
+	return acc;
+}
+
+size_t Resampler::resample(void *dest, const void *src, size_t srcFrames, Format format, double step)
+{
+	assumeExpr(step > 0.);
+	setChannels(format.channels);
+	if(auto newKernelStep = kernelStepForStep(step); newKernelStep != kernelStep)
+		makeKernels(newKernelStep);
+	appendSamples(input, src, srcFrames, format);
+	const size_t inputFrames = input[0].size();
+	auto destF = (float*)dest;
+	auto destI16 = (int16_t*)dest;
+	bool isFloat = format.sample.isFloat();
+	size_t destFrames{};
+	while((size_t)pos + halfTaps < inputFrames)
+	{
+		size_t base = (size_t)pos - (halfTaps - 1);
+		double phasePos = (pos - std::floor(pos)) * phases;
+		auto phase = (size_t)phasePos;
+		float mix = phasePos - phase;
+		auto k0 = kernels[phase].data();
+		auto k1 = kernels[phase + 1].data();
+		for(auto c : iotaCount(channels))
+		{
+			float s = filter(&input[c][base], k0, k1, mix);
+			if(isFloat)
+				*destF++ = s;
+			else
+				*destI16++ = std::clamp(s * 32768.f, -32768.f, 32767.f);
+		}
+		destFrames++;
+		pos += step;
+	}
+	// keep the tail of the input as history for the next call
+	size_t consumedFrames = inputFrames - historyFrames;
+	for(auto c : iotaCount(channels))
+	{
+		auto &i = input[c];
+		std::copy(i.end() - historyFrames, i.end(), i.begin());
+		i.resize(historyFrames);
+	}
+	pos -= consumedFrames;
+	return destFrames;
+}
+
+}
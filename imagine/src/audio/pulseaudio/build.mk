@@ -4,6 +4,9 @@ inc_audio_pa := 1
 configDefs += CONFIG_AUDIO_PULSEAUDIO
 
 ifeq ($(pulseAudioMainLoop), glib)
+ ifeq ($(linuxEventLoop), epoll)
+  $(error pulseAudioMainLoop=glib requires linuxEventLoop=glib)
+ endif
  configDefs += CONFIG_AUDIO_PULSEAUDIO_GLIB
  include $(IMAGINE_PATH)/make/package/pulseaudio-glib.mk
 else
@@ -0,0 +1,229 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "EventLoop"
+#include <imagine/base/EventLoop.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/logger/logger.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <array>
+
+namespace IG
+{
+
+static thread_local std::unique_ptr<EpollEventLoopData> threadEventLoop;
+
+static bool addFd(EpollEventLoopData &loop, int op, int fd, uint32_t events, void *data)
+{
+	epoll_event ev{.events = events, .data{.ptr = data}};
+	if(epoll_ctl(loop.epollFd, op, fd, &ev) == -1)
+	{
+		logErr("error in epoll_ctl for fd:%d (%s)", fd, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+static void removeFd(EpollFDEventSourceInfo &info)
+{
+	auto &loop = *info.loop;
+	epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, info.fd, nullptr);
+	// skip any events still pending for this source in the current dispatch
+	for(auto &e : loop.dispatchingEvents)
+	{
+		if(e.data.ptr == &info)
+			e = {};
+	}
+	info.loop = {};
+}
+
+EpollFDEventSource::EpollFDEventSource(const char *debugLabel, MaybeUniqueFileDescriptor fd):
+	debugLabel{debugLabel ? debugLabel : "unnamed"},
+	info{std::make_unique<EpollFDEventSourceInfo>()},
+	fd_{std::move(fd)}
+{}
+
+EpollFDEventSource::EpollFDEventSource(EpollFDEventSource &&o) noexcept
+{
+	*this = std::move(o);
+}
+
+EpollFDEventSource &EpollFDEventSource::operator=(EpollFDEventSource &&o) noexcept
+{
+	deinit();
+	info = std::move(o.info);
+	fd_ = std::move(o.fd_);
+	debugLabel = o.debugLabel;
+	return *this;
+}
+
+EpollFDEventSource::~EpollFDEventSource()
+{
+	deinit();
+}
+
+bool FDEventSource::attach(EventLoop loop, PollEventDelegate callback, uint32_t events)
+{
+	assumeExpr(info);
+	detach();
+	if(!loop)
+		loop = EventLoop::forThread();
+	if(!loop)
+	{
+		logErr("no event loop for thread to add fd:%d (%s)", (int)fd_, label());
+		return false;
+	}
+	logMsg("adding fd:%d to epoll:%d (%s)", (int)fd_, loop.nativeObject(), label());
+	if(!addFd(*loop.loopData(), EPOLL_CTL_ADD, fd_, events, info.get()))
+		return false;
+	info->callback = callback;
+	info->loop = loop.loopData();
+	info->fd = fd_;
+	return true;
+}
+
+void FDEventSource::detach()
+{
+	if(!info || !info->loop)
+		return;
+	logMsg("removing fd %d from epoll (%s)", (int)fd_, label());
+	removeFd(*info);
+}
+
+void FDEventSource::setEvents(uint32_t events)
+{
+	if(!hasEventLoop())
+	{
+		logErr("trying to set events while not attached to event loop");
+		return;
+	}
+	addFd(*info->loop, EPOLL_CTL_MOD, fd_, events, info.get());
+}
+
+void FDEventSource::dispatchEvents(uint32_t events)
+{
+	if(!info->callback(fd(), events) && info->loop)
+		removeFd(*info);
+}
+
+void FDEventSource::setCallback(PollEventDelegate callback)
+{
+	if(!hasEventLoop())
+	{
+		logErr("trying to set callback while not attached to event loop");
+		return;
+	}
+	info->callback = callback;
+}
+
+bool FDEventSource::hasEventLoop() const
+{
+	assumeExpr(info);
+	return info->loop;
+}
+
+int FDEventSource::fd() const
+{
+	return fd_;
+}
+
+void EpollFDEventSource::deinit()
+{
+	static_cast<FDEventSource*>(this)->detach();
+}
+
+const char *EpollFDEventSource::label() const
+{
+	return debugLabel;
+}
+
+EventLoop EventLoop::forThread()
+{
+	return {threadEventLoop.get()};
+}
+
+EventLoop EventLoop::makeForThread()
+{
+	if(threadEventLoop)
+		return {threadEventLoop.get()};
+	auto loop = std::make_unique<EpollEventLoopData>();
+	loop->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	loop->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(loop->epollFd == -1 || loop->wakeFd == -1)
+	{
+		logErr("error creating epoll event loop (%s)", strerror(errno));
+		return {};
+	}
+	// the wake fd is the only one registered without source info
+	if(!addFd(*loop, EPOLL_CTL_ADD, loop->wakeFd, EPOLLIN, nullptr))
+		return {};
+	if(Config::DEBUG_BUILD)
+	{
+		logMsg("made epoll:%d for thread:%d", (int)loop->epollFd, IG::thisThreadId());
+	}
+	threadEventLoop = std::move(loop);
+	return {threadEventLoop.get()};
+}
+
+void EventLoop::run()
+{
+	std::array<epoll_event, 16> events;
+	if(data->beforeWait)
+		data->beforeWait();
+	int count = epoll_wait(data->epollFd, events.data(), events.size(), -1);
+	if(count == -1)
+	{
+		if(errno != EINTR)
+			logErr("error in epoll_wait (%s)", strerror(errno));
+		return;
+	}
+	data->dispatchingEvents = {events.data(), size_t(count)};
+	for(auto &e : data->dispatchingEvents)
+	{
+		if(!e.data.ptr)
+		{
+			// wake fd or a source detached during this dispatch
+			if(e.events)
+			{
+				uint64_t val;
+				[[maybe_unused]] auto res = ::read(data->wakeFd, &val, sizeof(val));
+			}
+			continue;
+		}
+		auto &info = *static_cast<EpollFDEventSourceInfo*>(e.data.ptr);
+		int events = e.events;
+		bool keep = info.callback(info.fd, events);
+		// the callback may have detached or destroyed the source
+		if(!keep && e.data.ptr)
+			removeFd(info);
+	}
+	data->dispatchingEvents = {};
+}
+
+void EventLoop::stop()
+{
+	uint64_t val = 1;
+	[[maybe_unused]] auto res = ::write(data->wakeFd, &val, sizeof(val));
+}
+
+EventLoop::operator bool() const
+{
+	return data;
+}
+
+}
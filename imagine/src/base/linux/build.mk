@@ -23,13 +23,21 @@ ifeq ($(linuxWinSystem), x11)
  include $(imagineSrcDir)/base/x11/build.mk
 endif
 
-SRC += base/common/eventloop/GlibEventLoop.cc
-include $(IMAGINE_PATH)/make/package/glib.mk
-
-ifneq ($(SUBENV), pandora)
- configDefs += CONFIG_BASE_DBUS
- SRC += base/linux/dbus.cc
- include $(IMAGINE_PATH)/make/package/gio.mk
+# glib (default) or epoll, the latter removes the GLib dependency along with D-Bus support
+linuxEventLoop ?= glib
+
+ifeq ($(linuxEventLoop), epoll)
+ configDefs += CONFIG_BASE_EPOLL
+ SRC += base/common/eventloop/EpollEventLoop.cc
+else
+ SRC += base/common/eventloop/GlibEventLoop.cc
+ include $(IMAGINE_PATH)/make/package/glib.mk
+
+ ifneq ($(SUBENV), pandora)
+  configDefs += CONFIG_BASE_DBUS
+  SRC += base/linux/dbus.cc
+  include $(IMAGINE_PATH)/make/package/gio.mk
+ endif
 endif
 
 endif
@@ -23,12 +23,26 @@
 #include <imagine/util/format.hh>
 #include <sys/stat.h>
 #include <cstring>
+#include <ranges>
 
 namespace IG
 {
 
 constexpr mode_t defaultDirMode = S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH;
 
+static void makeDirWithParents(FS::PathString path)
+{
+	for(auto &c : path | std::views::drop(1))
+	{
+		if(c != '/')
+			continue;
+		c = 0;
+		mkdir(path.data(), defaultDirMode);
+		c = '/';
+	}
+	mkdir(path.data(), defaultDirMode);
+}
+
 LinuxApplication::LinuxApplication(ApplicationInitParams initParams):
 	BaseApplication{*initParams.ctxPtr}
 {
@@ -71,14 +85,14 @@ FS::PathString ApplicationContext::supportPath(const char *appName) const
 		home)
 	{
 		auto path = FS::pathString(home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	else if(auto home = getenv("HOME");
 		home)
 	{
 		auto path = FS::pathString(home, ".local/share", appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	logErr("XDG_DATA_HOME and HOME env variables not defined");
@@ -91,14 +105,14 @@ FS::PathString ApplicationContext::cachePath(const char *appName) const
 		home)
 	{
 		auto path = FS::pathString(home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	else if(auto home = getenv("HOME");
 		home)
 	{
 		auto path = FS::pathString(home, ".cache", appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	logErr("XDG_DATA_HOME and HOME env variables not defined");
@@ -29,6 +29,7 @@ static constexpr char ASCII_CR = 0xD;
 namespace IG
 {
 
+#ifdef CONFIG_BASE_GLIB
 struct XGlibSource : public GSource
 {
 	::Display *xDisplay{};
@@ -68,6 +69,7 @@ static GSourceFuncs x11SourceFuncs
 	.closure_callback{},
 	.closure_marshal{},
 };
+#endif
 
 XApplication::XApplication(ApplicationInitParams initParams):
 	LinuxApplication{initParams},
@@ -80,6 +82,10 @@ XApplication::~XApplication()
 {
 	deinitWindows();
 	deinitInputSystem();
+	#ifndef CONFIG_BASE_GLIB
+	if(auto loop = EventLoop::forThread())
+		loop.setBeforeWait({});
+	#endif
 	logMsg("closing X display");
 	XCloseDisplay(dpy);
 }
@@ -305,10 +311,24 @@ FDEventSource XApplication::makeXDisplayConnection(EventLoop loop)
 	initXScreens(appCtx, xDisplay);
 	initInputSystem();
 	FDEventSource x11Src{"XServer", ConnectionNumber(xDisplay)};
+	#ifdef CONFIG_BASE_GLIB
 	auto source = (XGlibSource*)g_source_new(&x11SourceFuncs, sizeof(XGlibSource));
 	source->xDisplay = xDisplay;
 	source->appPtr = this;
 	x11Src.attach(loop, source);
+	#else
+	x11Src.attach(loop,
+		[this, xDisplay](int, int)
+		{
+			runX11Events(xDisplay);
+			return true;
+		});
+	// other Xlib calls can read events into its queue without leaving any on the fd,
+	// so handle those before each wait like the glib source's prepare function
+	if(!loop)
+		loop = EventLoop::forThread();
+	loop.setBeforeWait([this, xDisplay](){ runX11Events(xDisplay); });
+	#endif
 	return x11Src;
 }
 
@@ -110,8 +110,10 @@ BitmapWriter::BitmapWriter(ApplicationContext ctx):
 	jWritePNG = {env, baseActivityCls, "writePNG", "(Landroid/graphics/Bitmap;Ljava/lang/String;)Z"};
 }
 
-bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
+bool PixmapWriter::writeToFile(PixmapView pix, const char *path, PixmapWriteParams params) const
 {
+	if(params.format == PixmapFileFormat::BMP)
+		return writeBMPFile(pix, path);
 	auto env = app().thisThreadJniEnv();
 	auto aFormat = pix.format().id() == PIXEL_RGB565 ? ANDROID_BITMAP_FORMAT_RGB_565 : ANDROID_BITMAP_FORMAT_RGBA_8888;
 	auto bitmap = jMakeBitmap(env, baseActivity, pix.w(), pix.h(), aFormat);
@@ -0,0 +1,76 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "BMP"
+#include <imagine/data-type/image/PixmapWriter.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/logger/logger.h>
+#include <array>
+#include <cstring>
+
+namespace IG::Data
+{
+
+template <class T>
+static void writeLE(uint8_t *&data, T val)
+{
+	for(auto i : iotaCount(sizeof(T)))
+	{
+		*data++ = uint8_t(val >> (i * 8));
+	}
+}
+
+// Writes a 32-bit uncompressed top-down BMP, avoiding any encoding cost beyond a format conversion
+bool writeBMPFile(PixmapView pix, const char *path)
+{
+	constexpr uint32_t fileHeaderSize = 14;
+	constexpr uint32_t infoHeaderSize = 40;
+	constexpr uint32_t headerSize = fileHeaderSize + infoHeaderSize;
+	MemPixmap tempMemPix{{pix.size(), PIXEL_FMT_BGRA8888}};
+	auto tempPix = tempMemPix.view();
+	tempPix.writeConverted(pix);
+	uint32_t imageSize = tempPix.bytes();
+	std::array<uint8_t, headerSize> header{};
+	auto data = header.data();
+	*data++ = 'B'; *data++ = 'M';
+	writeLE<uint32_t>(data, headerSize + imageSize);
+	writeLE<uint32_t>(data, 0); // reserved
+	writeLE<uint32_t>(data, headerSize); // pixel data offset
+	writeLE<uint32_t>(data, infoHeaderSize);
+	writeLE<int32_t>(data, pix.w());
+	writeLE<int32_t>(data, -pix.h()); // negative height for top-down rows
+	writeLE<uint16_t>(data, 1); // planes
+	writeLE<uint16_t>(data, 32); // bits per pixel
+	writeLE<uint32_t>(data, 0); // BI_RGB
+	writeLE<uint32_t>(data, imageSize);
+	FileIO file{path, OpenFlagsMask::NEW | OpenFlagsMask::TEST};
+	if(!file)
+	{
+		return false;
+	}
+	if(file.write(header.data(), header.size()) != (ssize_t)header.size() ||
+		file.write(tempPix.data(), imageSize) != (ssize_t)imageSize)
+	{
+		logErr("error writing BMP file:%s", path);
+		file = {};
+		FS::remove(path);
+		return false;
+	}
+	return true;
+}
+
+}
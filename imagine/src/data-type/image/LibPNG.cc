@@ -26,6 +26,7 @@
 #include <imagine/pixmap/MemPixmap.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
 
 #ifdef CONFIG_MACHINE_PANDORA
 // remap type name for libpng 1.2
@@ -396,8 +397,24 @@ PixmapImage PixmapReader::loadAsset(const char *name, const char *appName) const
 	return load(appContext().openAsset(name, IOAccessHint::ALL, {}, appName));
 }
 
-bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
+static int pngFilterFlags(PngFilter filter)
 {
+	switch(filter)
+	{
+		case PngFilter::DEFAULT: break;
+		case PngFilter::NONE: return PNG_FILTER_NONE;
+		case PngFilter::SUB: return PNG_FILTER_SUB;
+		case PngFilter::UP: return PNG_FILTER_UP;
+		case PngFilter::PAETH: return PNG_FILTER_PAETH;
+		case PngFilter::ALL: return PNG_ALL_FILTERS;
+	}
+	return -1;
+}
+
+bool PixmapWriter::writeToFile(PixmapView pix, const char *path, PixmapWriteParams params) const
+{
+	if(params.format == PixmapFileFormat::BMP)
+		return writeBMPFile(pix, path);
 	FileIO fp{path, OpenFlagsMask::NEW | OpenFlagsMask::TEST};
 	if(!fp)
 	{
@@ -440,6 +457,10 @@ bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
 		PNG_COLOR_TYPE_RGB,
 		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
 		PNG_FILTER_TYPE_DEFAULT);
+	if(params.compressionLevel >= 0)
+		png_set_compression_level(pngPtr, std::min((int)params.compressionLevel, 9));
+	if(auto filters = pngFilterFlags(params.filter); filters != -1)
+		png_set_filter(pngPtr, PNG_FILTER_TYPE_BASE, filters);
 	png_write_info(pngPtr, infoPtr);
 	{
 		MemPixmap tempMemPix{{pix.size(), PIXEL_FMT_RGB888}};
@@ -23,8 +23,10 @@ static_assert(__has_feature(objc_arc), "This file requires ARC");
 namespace IG::Data
 {
 
-bool PixmapWriter::writeToFile(PixmapView srcPix, const char *path) const
+bool PixmapWriter::writeToFile(PixmapView srcPix, const char *path, PixmapWriteParams params) const
 {
+	if(params.format == PixmapFileFormat::BMP)
+		return writeBMPFile(srcPix, path);
 	IG::MemPixmap tempMemPix{{srcPix.size(), IG::PIXEL_FMT_RGB888}};
 	auto pix = tempMemPix.view();
 	pix.writeConverted(srcPix);
@@ -4,4 +4,6 @@ else ifeq ($(ENV), android)
  include $(imagineSrcDir)/data-type/image/android.mk
 else
  include $(imagineSrcDir)/data-type/image/libpng.mk
-endif
\ No newline at end of file
+endif
+
+SRC += data-type/image/BMP.cc
@@ -3,6 +3,7 @@ inc_fs_archive := 1
 
 include $(IMAGINE_PATH)/src/io/ArchiveIO.mk
 
-SRC += fs/ArchiveFS.cc
+SRC += fs/ArchiveFS.cc \
+fs/ArchiveIndex.cc
 
 endif
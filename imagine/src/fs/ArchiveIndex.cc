@@ -0,0 +1,165 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "ArchIndex"
+#include <imagine/fs/ArchiveIndex.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
+
+namespace IG::FS
+{
+
+ArchiveIndex::ArchiveIndex(CStringView path, size_t cacheCapacity):
+	reader{path}, cacheCapacity_{cacheCapacity}
+{
+	init();
+}
+
+ArchiveIndex::ArchiveIndex(IO io, size_t cacheCapacity):
+	reader{std::move(io)}, cacheCapacity_{cacheCapacity}
+{
+	init();
+}
+
+void ArchiveIndex::init()
+{
+	if(!reader.hasEntry())
+		return;
+	do
+	{
+		entries_.emplace_back(std::string{reader.name()}, reader.size(), reader.crc32(), reader.type());
+	} while(reader.readNextEntry());
+	// reader is past the last entry, the next open will rewind
+	readerIdx = entries_.size();
+	readerDataConsumed = true;
+	logMsg("indexed %zu archive entries", entries_.size());
+}
+
+const ArchiveIndex::Entry *ArchiveIndex::find(std::string_view name) const
+{
+	auto it = std::ranges::find_if(entries_, [&](auto &e){ return e.type != file_type::directory && e.name == name; });
+	return it != entries_.end() ? &*it : nullptr;
+}
+
+const ArchiveIndex::Entry *ArchiveIndex::findCRC32(uint32_t crc) const
+{
+	auto it = std::ranges::find_if(entries_, [&](auto &e){ return e.type != file_type::directory && e.crc32 == crc; });
+	return it != entries_.end() ? &*it : nullptr;
+}
+
+bool ArchiveIndex::seekReader(size_t idx)
+{
+	if(idx < readerIdx || (idx == readerIdx && readerDataConsumed))
+	{
+		reader.rewind();
+		readerIdx = 0;
+		readerDataConsumed = false;
+	}
+	while(readerIdx < idx)
+	{
+		// skipped entries don't need their data decompressed unless the archive is solid
+		if(!reader.readNextEntry())
+		{
+			readerIdx = entries_.size();
+			readerDataConsumed = true;
+			return false;
+		}
+		readerIdx++;
+		readerDataConsumed = false;
+	}
+	return true;
+}
+
+IO ArchiveIndex::open(const Entry &entry)
+{
+	assumeExpr(&entry >= entries_.data() && &entry < entries_.data() + entries_.size());
+	size_t idx = &entry - entries_.data();
+	auto size = entry.size;
+	if(auto it = std::ranges::find_if(cache, [&](auto &c){ return c.entryIdx == idx; });
+		it != cache.end())
+	{
+		//logMsg("using cached entry:%s", entry.name.data());
+		cache.splice(cache.begin(), cache, it);
+		auto buff = std::make_unique<uint8_t[]>(size);
+		std::memcpy(buff.get(), it->data.get(), size);
+		return MapIO{IOBuffer{{buff.release(), size}, 0, [](const uint8_t *ptr, size_t){ delete[] ptr; }}};
+	}
+	if(!reader.archive())
+	{
+		logErr("can't open entry:%s while a streamed entry is open", entry.name.data());
+		return {};
+	}
+	if(!seekReader(idx))
+	{
+		logErr("error seeking to entry:%s", entry.name.data());
+		return {};
+	}
+	if(!size || size > cacheCapacity_)
+	{
+		// no copy is kept, so avoid holding the whole entry in memory
+		readerDataConsumed = true;
+		return reader.moveIO();
+	}
+	auto buff = std::make_unique<uint8_t[]>(size);
+	auto io = reader.moveIO();
+	auto bytesRead = io.read(buff.get(), size);
+	reader.moveIO(std::move(io));
+	readerDataConsumed = true;
+	if(bytesRead != (ssize_t)size)
+	{
+		logErr("error reading entry:%s", entry.name.data());
+		return {};
+	}
+	// the cache keeps its own copy since callers may modify the returned data
+	evictCache(size);
+	auto cachedData = std::make_unique<uint8_t[]>(size);
+	std::memcpy(cachedData.get(), buff.get(), size);
+	cache.emplace_front(std::move(cachedData), size, idx);
+	cacheSize_ += size;
+	return MapIO{IOBuffer{{buff.release(), size}, 0, [](const uint8_t *ptr, size_t){ delete[] ptr; }}};
+}
+
+void ArchiveIndex::close(IO io)
+{
+	// streamed entries return the reader to the index
+	if(auto archIO = std::get_if<ArchiveIO>(&io))
+		reader.moveIO(std::move(*archIO));
+}
+
+void ArchiveIndex::evictCache(size_t bytesNeeded)
+{
+	while(cache.size() && cacheSize_ + bytesNeeded > cacheCapacity_)
+	{
+		cacheSize_ -= cache.back().size;
+		cache.pop_back();
+	}
+}
+
+void ArchiveIndex::setCacheCapacity(size_t bytes)
+{
+	cacheCapacity_ = bytes;
+	evictCache(0);
+}
+
+void ArchiveIndex::clearCache()
+{
+	cache.clear();
+	cacheSize_ = 0;
+}
+
+}
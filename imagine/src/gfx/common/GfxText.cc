@@ -22,15 +22,57 @@
 #include <imagine/gfx/GeomQuad.hh>
 #include <imagine/util/math/int.hh>
 #include <imagine/util/ctype.hh>
+#include <imagine/util/container/ArrayList.hh>
+#include <imagine/util/ranges.hh>
 #include <imagine/logger/logger.h>
 #include <algorithm>
 #include <bit>
+#include <limits>
 
 namespace IG::Gfx
 {
 
+// Glyph quads sharing an atlas texture are drawn together, up to the number of quads addressable by VertexIndex
+class GlyphQuadBatch
+{
+public:
+	static constexpr size_t maxQuads = (std::numeric_limits<VertexIndex>::max() + 1) / 4;
+
+	void add(RendererCommands &cmds, GCRect rect, TextureSpan glyph)
+	{
+		if(glyph.texture() != texture || quads.size() == maxQuads)
+		{
+			draw(cmds);
+			texture = glyph.texture();
+		}
+		quads.emplace_back(rect, glyph);
+	}
+
+	void draw(RendererCommands &cmds)
+	{
+		if(quads.empty())
+			return;
+		cmds.setTexture(*texture);
+		drawQuads(cmds, quads, std::span{quadIdxs}.first(quads.size()));
+		quads.clear();
+	}
+
+protected:
+	static constexpr auto quadIdxs = []()
+	{
+		std::array<std::array<VertexIndex, 6>, maxQuads> idxs;
+		for(auto i : iotaCount(maxQuads))
+		{
+			idxs[i] = makeRectIndexArray(i);
+		}
+		return idxs;
+	}();
+	StaticArrayList<TexQuad, maxQuads> quads;
+	const Texture *texture{};
+};
+
 static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionPlane projP,
-	std::u16string_view strView, TexQuad &vArr, GlyphTextureSet *face_, float spaceSize);
+	std::u16string_view strView, GlyphQuadBatch &batch, GlyphTextureSet *face_, float spaceSize);
 
 void Text::setFace(GlyphTextureSet *face_)
 {
@@ -158,9 +200,7 @@ void Text::draw(RendererCommands &cmds, FP p, _2DOrigin o, ProjectionPlane projP
 	auto [xPos, yPos] = p;
 	//logMsg("drawing with origin: %s,%s", o.toString(o.x), o.toString(o.y));
 	cmds.set(BlendMode::ALPHA);
-	TexQuad vArr;
-	cmds.bindTempVertexBuffer();
-	cmds.setVertexAttribs(vArr.data());
+	GlyphQuadBatch batch;
 	_2DOrigin align = o;
 	xPos = o.adjustX(xPos, xSize, LT2DO);
 	//logMsg("aligned to %f, converted to %d", Gfx::alignYToPixel(yPos), toIYPos(Gfx::alignYToPixel(yPos)));
@@ -187,7 +227,7 @@ void Text::draw(RendererCommands &cmds, FP p, _2DOrigin o, ProjectionPlane projP
 			spansPtr += LineSpan::encodedChar16Size;
 			xPos = startingXPos(xLineSize);
 			//logMsg("line %d, %d chars", l, charsToDraw);
-			drawSpan(cmds, xPos, yPos, projP, std::u16string_view{s, charsToDraw}, vArr, face_, spaceSize);
+			drawSpan(cmds, xPos, yPos, projP, std::u16string_view{s, charsToDraw}, batch, face_, spaceSize);
 			s += charsToDraw;
 			yPos -= nominalHeight_;
 			yPos = projP.alignYToPixel(yPos);
@@ -198,12 +238,13 @@ void Text::draw(RendererCommands &cmds, FP p, _2DOrigin o, ProjectionPlane projP
 		float xLineSize = xSize;
 		xPos = startingXPos(xLineSize);
 		//logMsg("line %d, %d chars", l, charsToDraw);
-		drawSpan(cmds, xPos, yPos, projP, std::u16string_view{textStr}, vArr, face_, spaceSize);
+		drawSpan(cmds, xPos, yPos, projP, std::u16string_view{textStr}, batch, face_, spaceSize);
 	}
+	batch.draw(cmds);
 }
 
 static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionPlane projP,
-	std::u16string_view strView, TexQuad &vArr, GlyphTextureSet *face_, float spaceSize)
+	std::u16string_view strView, GlyphQuadBatch &batch, GlyphTextureSet *face_, float spaceSize)
 {
 	auto xViewLimit = projP.wHalf();
 	for(auto c : strView)
@@ -227,12 +268,7 @@ static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionP
 		float xSize = projP.unprojectXSize(gly->metrics.xSize);
 		auto x = xPos + projP.unprojectXSize(gly->metrics.xOffset);
 		auto y = yPos - projP.unprojectYSize(gly->metrics.ySize - gly->metrics.yOffset);
-		auto &glyph = gly->glyph();
-		vArr = {{{x, y}, {x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}}, glyph};
-		cmds.vertexBufferData(vArr.data(), sizeof(vArr));
-		cmds.setTexture(glyph);
-		//logMsg("drawing");
-		cmds.drawPrimitives(Primitive::TRIANGLE_STRIP, 0, 4);
+		batch.add(cmds, {{x, y}, {x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}}, gly->glyph());
 		xPos += projP.unprojectXSize(gly->metrics.xAdvance);
 	}
 }
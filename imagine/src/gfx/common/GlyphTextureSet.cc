@@ -20,6 +20,8 @@
 #include <imagine/gfx/GlyphTextureSet.hh>
 #include <imagine/data-type/image/PixmapSource.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <bit>
 #include <cstdlib>
 
 namespace IG::Gfx
@@ -36,6 +38,9 @@ static constexpr int unicodeBmpUsedChars = unicodeBmpChars - unicodeBmpPrivateCh
 
 static constexpr int glyphTableEntries = unicodeBmpUsedChars;
 
+// empty space kept right & below each atlas glyph so filtering doesn't sample its neighbors
+static constexpr int atlasGlyphPadding = 1;
+
 static std::errc mapCharToTable(int c, int &tableIdx);
 
 static int charIsDrawableUnicode(int c)
@@ -48,8 +53,14 @@ static int charIsDrawableUnicode(int c)
 			);
 }
 
+static int charPlane(int c)
+{
+	return (c >> 11) & 0x1F; // use upper 5 BMP plane bits to map in range 0-31
+}
+
 void GlyphTextureSet::resetGlyphTable()
 {
+	atlasPages.clear();
 	if(!usedGlyphTableBits)
 		return;
 	logMsg("resetting glyph table");
@@ -72,7 +83,7 @@ void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 		{
 			logMsg("purging glyphs from table range %d/31", i);
 			int firstChar = i << 11;
-			for(auto c : std::views::iota(firstChar, 2048))
+			for(auto c : std::views::iota(firstChar, firstChar + 2048))
 			{
 				int tableIdx;
 				if((bool)mapCharToTable(c, tableIdx))
@@ -80,8 +91,9 @@ void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 					//logMsg( "%c not a known drawable character, skipping", c);
 					continue;
 				}
-				glyphTable[i].~GlyphEntry();
+				glyphTable[tableIdx] = {};
 			}
+			std::erase_if(atlasPages, [&](auto &page){ return page->plane == (int)i; });
 			usedGlyphTableBits = IG::clearBits(usedGlyphTableBits, IG::bit(i));
 		}
 		tableBits >>= 1;
@@ -134,6 +146,8 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 		return false;
 	resetGlyphTable();
 	settings = set;
+	// fit around 16 rows of glyphs per atlas page
+	atlasPageSize = std::clamp((int)std::bit_ceil(unsigned(settings.pixelHeight()) * 16), 256, 2048);
 	std::errc ec{};
 	faceSize = font.makeSize(settings, ec);
 	calcMetrics(r);
@@ -158,13 +172,65 @@ std::errc GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 		return ec;
 	}
 	//logMsg("setting up table entry %d", tableIdx);
+	auto glyph = addToAtlas(r, res.image.pixmap(), charPlane(c));
+	if(!glyph)
+	{
+		glyphTable[tableIdx].metrics.ySize = -1;
+		return std::errc::not_enough_memory;
+	}
 	glyphTable[tableIdx].metrics = res.metrics;
-	glyphTable[tableIdx].glyph_ = r.makeTexture(res.image, glyphSamplerConfig, false);
-	usedGlyphTableBits |= IG::bit((c >> 11) & 0x1F); // use upper 5 BMP plane bits to map in range 0-31
+	glyphTable[tableIdx].glyph_ = glyph;
+	usedGlyphTableBits |= IG::bit(charPlane(c));
 	//logMsg("used table bits 0x%X", usedGlyphTableBits);
 	return {};
 }
 
+static bool allocShelfRect(GlyphAtlasPage &page, WP size, int pageSize, WP &pos)
+{
+	if(page.shelfPos.x + size.x > pageSize)
+	{
+		// start a new shelf below the current one
+		if(page.shelfPos.y + page.shelfHeight + size.y > pageSize)
+			return false;
+		page.shelfPos = {0, page.shelfPos.y + page.shelfHeight};
+		page.shelfHeight = 0;
+	}
+	if(page.shelfPos.y + size.y > pageSize)
+		return false;
+	pos = page.shelfPos;
+	page.shelfPos.x += size.x;
+	page.shelfHeight = std::max(page.shelfHeight, size.y);
+	return true;
+}
+
+TextureSpan GlyphTextureSet::addToAtlas(Renderer &r, PixmapView pix, int plane)
+{
+	WP allocSize = pix.size() + WP{atlasGlyphPadding, atlasGlyphPadding};
+	if(allocSize.x > atlasPageSize || allocSize.y > atlasPageSize) [[unlikely]]
+	{
+		logErr("glyph size %dx%d larger than atlas page", pix.w(), pix.h());
+		return {};
+	}
+	// only the newest page of the plane has free shelf space
+	auto pageIt = std::find_if(atlasPages.rbegin(), atlasPages.rend(), [&](auto &page){ return page->plane == plane; });
+	GlyphAtlasPage *page = pageIt != atlasPages.rend() ? pageIt->get() : nullptr;
+	WP pos;
+	if(!page || !allocShelfRect(*page, allocSize, atlasPageSize, pos))
+	{
+		logMsg("making %dx%d glyph atlas page for plane:%d", atlasPageSize, atlasPageSize, plane);
+		page = atlasPages.emplace_back(std::make_unique<GlyphAtlasPage>(
+			r.makeTexture({{{atlasPageSize, atlasPageSize}, pix.format()}, glyphSamplerConfig}))).get();
+		page->plane = plane;
+		page->texture.clear(0);
+		allocShelfRect(*page, allocSize, atlasPageSize, pos);
+	}
+	if(pix.w() && pix.h())
+		page->texture.write(0, pix, pos);
+	float pageSize = atlasPageSize;
+	return {&page->texture, {{pos.x / pageSize, pos.y / pageSize},
+		{(pos.x + pix.w()) / pageSize, (pos.y + pix.h()) / pageSize}}};
+}
+
 static std::errc mapCharToTable(int c, int &tableIdx)
 {
 	//logMsg("mapping char 0x%X", c);
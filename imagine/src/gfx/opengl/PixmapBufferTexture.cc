@@ -169,6 +169,17 @@ void PixmapBufferTexture::write(PixmapView pixmap, uint32_t writeFlags)
 	writeAligned(pixmap, Texture::bestAlignment(pixmap), writeFlags);
 }
 
+bool PixmapBufferTexture::writeRows(PixmapView pixmap, int destRow, uint32_t writeFlags)
+{
+	return visit([&](auto &t)
+	{
+		if constexpr(requires {t.writeRowsAligned(pixmap, destRow, 0, writeFlags);})
+			return t.writeRowsAligned(pixmap, destRow, Texture::bestAlignment(pixmap), writeFlags);
+		else
+			return false;
+	}, directTex);
+}
+
 void PixmapBufferTexture::clear()
 {
 	auto lockBuff = lock(Texture::BUFFER_FLAG_CLEARED);
@@ -285,6 +296,16 @@ void GLTextureStorage<Impl, BufferInfo>::writeAligned(PixmapView pixmap, int ass
 	}
 }
 
+template<class Impl, class BufferInfo>
+bool GLTextureStorage<Impl, BufferInfo>::writeRowsAligned(PixmapView pixmap, int destRow, int assumeAlign, uint32_t writeFlags)
+{
+	// the staging buffers may hold older frames, so only direct texture writes keep the other rows intact
+	if(!renderer().support.hasUnpackRowLength && pixmap.isPadded())
+		return false;
+	Texture::writeAligned(0, pixmap, {0, destRow}, assumeAlign, writeFlags);
+	return true;
+}
+
 GLSystemMemoryStorage::GLSystemMemoryStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer):
 	GLTextureStorage{rTask, config, singleBuffer}
 {
@@ -27,12 +27,111 @@
 #include <imagine/util/math/int.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/util/hash.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/time/Time.hh>
+#include <algorithm>
+#include <charconv>
 #include <string>
 #include <system_error>
 
 namespace IG
 {
 
+// Listings of large directories are cached to speed up re-entering them on slow storage.
+// Each cache file is named by a hash of the directory path and stored as text: a header line,
+// the directory path, its last write time, one "<d|f>\t<name>\t<path>" line per entry, then an end line.
+// A listing is only used if the directory's last write time still matches.
+
+static constexpr std::string_view dirCacheHeader = "# imagine directory cache v1";
+static constexpr std::string_view dirCacheEnd = "# end";
+static constexpr size_t minCachedDirEntries = 128;
+static constexpr size_t maxDirEntryBatch = 256;
+static constexpr auto maxDirEntryBatchTime = Milliseconds{100};
+
+struct CachedDirEntry
+{
+	std::string name;
+	std::string path;
+	bool isDir;
+};
+
+static FS::PathString dirCacheFilePath(std::string_view cacheDir, std::string_view dirPath)
+{
+	auto hash = hashBytes({(const unsigned char*)dirPath.data(), dirPath.size()});
+	return FS::pathString(cacheDir, fmt::format("{:016x}", hash));
+}
+
+static std::vector<CachedDirEntry> readDirCache(CStringView cacheFile, std::string_view dirPath, FS::file_time_type lastWriteTime)
+{
+	auto buff = FileUtils::bufferFromPath(cacheFile, OpenFlagsMask::TEST);
+	if(!buff)
+		return {};
+	std::string_view str{(const char*)buff.data(), buff.size()};
+	auto nextLine = [&]()
+	{
+		auto end = str.find('\n');
+		if(end == str.npos)
+		{
+			str = {};
+			return std::string_view{};
+		}
+		auto line = str.substr(0, end);
+		str.remove_prefix(end + 1);
+		return line;
+	};
+	if(nextLine() != dirCacheHeader || nextLine() != dirPath)
+		return {};
+	auto timeStr = nextLine();
+	FS::file_time_type::rep time{};
+	if(std::from_chars(timeStr.data(), timeStr.data() + timeStr.size(), time).ec != std::errc{} ||
+		FS::file_time_type{time} != lastWriteTime)
+	{
+		logMsg("directory cache:%s is outdated", cacheFile.data());
+		return {};
+	}
+	std::vector<CachedDirEntry> entries;
+	while(true)
+	{
+		auto line = nextLine();
+		if(line == dirCacheEnd)
+			return entries;
+		auto nameStart = line.find('\t');
+		auto pathStart = line.find('\t', nameStart + 1);
+		if(line.size() < 2 || nameStart != 1 || pathStart == line.npos)
+		{
+			logErr("directory cache:%s is corrupt", cacheFile.data());
+			return {};
+		}
+		entries.emplace_back(std::string{line.substr(2, pathStart - 2)}, std::string{line.substr(pathStart + 1)}, line[0] == 'd');
+	}
+}
+
+static void writeDirCache(CStringView cacheDir, CStringView cacheFile, std::string_view dirPath,
+	FS::file_time_type lastWriteTime, const std::vector<CachedDirEntry> &entries)
+{
+	// skip directories modified within the timestamp resolution since later changes wouldn't be detected
+	if(entries.size() < minCachedDirEntries || lastWriteTime.count() <= 0 ||
+		lastWriteTime >= std::chrono::duration_cast<FS::file_time_type>(wallClockTimestamp()) - Seconds{2})
+	{
+		return;
+	}
+	std::string str{fmt::format("{}\n{}\n{}\n", dirCacheHeader, dirPath, lastWriteTime.count())};
+	for(const auto &e : entries)
+	{
+		if(e.name.find_first_of("\t\n") != e.name.npos || e.path.find_first_of("\t\n") != e.path.npos)
+			return;
+		str += fmt::format("{}\t{}\t{}\n", e.isDir ? 'd' : 'f', e.name, e.path);
+	}
+	str += dirCacheEnd;
+	str += '\n';
+	FS::create_directory(cacheDir);
+	if(FileUtils::writeToPath(cacheFile, std::span{(const unsigned char*)str.data(), str.size()}) == -1)
+		logErr("error writing directory cache:%s", cacheFile.data());
+	else
+		logMsg("wrote directory cache:%s with %zu entries", cacheFile.data(), entries.size());
+}
+
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
 	View{attach},
@@ -74,6 +173,14 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 	controller.push(makeView<TableView>([](const TableView &) { return 0; },
 		[&d = dir](const TableView &, size_t idx) -> MenuItem& { return d[idx].text; }));
 	controller.navView()->showLeftBtn(true);
+	fileTableView().setLazyItemCompile(true);
+	fileTableView().setOnSelectElement(
+		[this](const Input::Event &e, int i, MenuItem &)
+		{
+			selectEntry(i, e);
+		});
+	if(auto cachePath = appContext().cachePath(); cachePath.size())
+		dirCachePath = FS::pathString(cachePath, "dirListCache");
 	dir.reserve(16); // start with some initial capacity to avoid small reallocations
 }
 
@@ -158,13 +265,12 @@ void FSPicker::prepareDraw()
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds)
 {
-	if(!dirListThread.isWorking())
+	if(dir.size())
+	{
+		controller.top().draw(cmds);
+	}
+	else if(!dirListThread.isWorking())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
 		{
 			using namespace IG::Gfx;
 			cmds.set(ColorName::WHITE);
@@ -190,6 +296,10 @@ void FSPicker::setEmptyPath(std::string_view message)
 	dirListEvent.cancel();
 	root = {};
 	dir.clear();
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		pendingDir.clear();
+	}
 	msgText.resetString(message);
 	if(mode_ == Mode::FILE_IN_DIR)
 	{
@@ -436,14 +546,19 @@ void FSPicker::startDirectoryListThread(CStringView path)
 		return;
 	}
 	dir.clear();
-	fileTableView().setItemsDelegate();
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		pendingDir.clear();
+	}
+	fileTableView().setItemsDelegate([&d = dir](const TableView &) { return d.size(); });
+	fileTableView().resetScroll();
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().setItemsDelegate([&d = dir](const TableView &) { return d.size(); });
-		if(highlightFirstDirEntry)
+		// entries are shown as they arrive, sorted into the existing ones
+		bool wasEmpty = dir.empty();
+		mergePendingEntries();
+		if(wasEmpty && dir.size() && highlightFirstDirEntry)
 			fileTableView().highlightCell(0);
-		else
-			fileTableView().resetScroll();
 		place();
 		postDraw();
 	});
@@ -458,77 +573,141 @@ void FSPicker::startDirectoryListThread(CStringView path)
 	}, std::string{path});
 }
 
+static bool fileEntryLess(const auto &e1, const auto &e2)
+{
+	if(e1.isDir() && !e2.isDir())
+		return true;
+	else if(!e1.isDir() && e2.isDir())
+		return false;
+	else
+		return caselessLexCompare(e1.path, e2.path);
+}
+
+void FSPicker::addPendingEntries(std::vector<FileEntry> &entries)
+{
+	if(entries.empty())
+		return;
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		pendingDir.insert(pendingDir.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+	}
+	entries.clear();
+	dirListEvent.notify();
+}
+
+void FSPicker::mergePendingEntries()
+{
+	std::vector<FileEntry> entries;
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		entries.swap(pendingDir);
+	}
+	if(entries.empty())
+		return;
+	std::sort(entries.begin(), entries.end(), fileEntryLess<FileEntry, FileEntry>);
+	auto sortedSize = dir.size();
+	dir.insert(dir.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+	std::inplace_merge(dir.begin(), dir.begin() + sortedSize, dir.end(), fileEntryLess<FileEntry, FileEntry>);
+}
+
+void FSPicker::selectEntry(size_t idx, const Input::Event &e)
+{
+	if(idx >= dir.size()) [[unlikely]]
+		return;
+	auto &entry = dir[idx];
+	if(entry.isDir())
+	{
+		assert(!isSingleDirectoryMode());
+		auto path = std::move(entry.path);
+		logMsg("entering dir:%s", path.data());
+		changeDirByInput(path, root.info, e);
+	}
+	else
+	{
+		onSelectPath_.callCopy(*this, entry.path, appContext().fileUriDisplayName(entry.path), e);
+	}
+}
+
 void FSPicker::listDirectory(IG::CStringView path, ThreadStop &stop)
 {
+	std::vector<FileEntry> batch;
+	auto lastBatchTime = steadyClockTimestamp();
+	size_t entries{};
+	auto addEntry = [&](const FS::directory_entry &entry)
+	{
+		bool isDir = entry.type() == FS::file_type::directory;
+		if(mode_ == Mode::DIR) // filter non-directories
+		{
+			if(!isDir)
+				return;
+		}
+		else if(mode_ == Mode::FILE_IN_DIR) // filter directories
+		{
+			if(isDir)
+				return;
+		}
+		if(!showHiddenFiles_ && entry.name().starts_with('.'))
+		{
+			return;
+		}
+		if(filter && !filter(entry))
+		{
+			return;
+		}
+		auto &item = batch.emplace_back(FileEntry{std::string{entry.path()}, {entry.name(), &face(), nullptr}});
+		if(isDir)
+			item.text.setFlags(item.text.flags() | FileEntry::IS_DIR_FLAG);
+		entries++;
+		if(auto now = steadyClockTimestamp();
+			batch.size() >= maxDirEntryBatch || now - lastBatchTime >= maxDirEntryBatchTime)
+		{
+			addPendingEntries(batch);
+			lastBatchTime = now;
+		}
+	};
 	try
 	{
-		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
+		auto ctx = appContext();
+		auto lastWriteTime = dirCachePath.size() ? ctx.fileUriLastWriteTime(path) : FS::file_time_type{};
+		auto cacheFile = dirCacheFilePath(dirCachePath, path);
+		if(auto cachedEntries = lastWriteTime.count() > 0 ? readDirCache(cacheFile, path, lastWriteTime) : std::vector<CachedDirEntry>{};
+			cachedEntries.size())
+		{
+			logMsg("using cached listing with %zu entries", cachedEntries.size());
+			for(const auto &e : cachedEntries)
 			{
-				//logMsg("entry:%s", entry.path().data());
 				if(stop) [[unlikely]]
 				{
 					logMsg("interrupted listing directory");
-					return false;
-				}
-				bool isDir = entry.type() == FS::file_type::directory;
-				if(mode_ == Mode::DIR) // filter non-directories
-				{
-					if(!isDir)
-						return true;
-				}
-				else if(mode_ == Mode::FILE_IN_DIR) // filter directories
-				{
-					if(isDir)
-						return true;
-				}
-				if(!showHiddenFiles_ && entry.name().starts_with('.'))
-				{
-					return true;
+					return;
 				}
-				if(filter && !filter(entry))
-				{
-					return true;
-				}
-				auto &item = dir.emplace_back(FileEntry{std::string{entry.path()}, {entry.name(), &face(), nullptr}});
-				if(isDir)
-					item.text.setFlags(item.text.flags() | FileEntry::IS_DIR_FLAG);
-				return true;
-			});
-		std::sort(dir.begin(), dir.end(),
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return caselessLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+				addEntry(FS::directory_entry{e.path, e.name, e.isDir ? FS::file_type::directory : FS::file_type::regular});
+			}
+		}
+		else
 		{
-			for(auto &d : dir)
+			std::vector<CachedDirEntry> listedEntries;
+			auto onEntry = [&](const FS::directory_entry &entry)
 			{
-				if(d.isDir())
-				{
-					d.text.setOnSelect(
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							logMsg("entering dir:%s", path.data());
-							changeDirByInput(path, root.info, e);
-						});
-				}
-				else
+				//logMsg("entry:%s", entry.path().data());
+				if(stop) [[unlikely]]
 				{
-					d.text.setOnSelect(
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						});
+					logMsg("interrupted listing directory");
+					return false;
 				}
-			}
+				if(lastWriteTime.count() > 0)
+					listedEntries.emplace_back(std::string{entry.name()}, std::string{entry.path()}, entry.type() == FS::file_type::directory);
+				addEntry(entry);
+				return true;
+			};
+			ctx.forEachInDirectoryUri(path, [&onEntry](auto &entry){ return onEntry(entry); });
+			if(stop)
+				return;
+			writeDirCache(dirCachePath, cacheFile, path, lastWriteTime, listedEntries);
+		}
+		addPendingEntries(batch);
+		if(entries)
+		{
 			msgText.resetString();
 		}
 		else // no entries, show a message instead
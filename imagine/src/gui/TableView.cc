@@ -78,7 +78,13 @@ void TableView::prepareDraw()
 	}
 	for(size_t i = startYCell; i < endYCell; i++)
 	{
-		item(*this, i).prepareDraw(renderer());
+		auto &it = item(*this, i);
+		if(it.needsCompile())
+		{
+			it.compile(renderer(), projP);
+			it.setNeedsCompile(false);
+		}
+		it.prepareDraw(renderer());
 	}
 }
 
@@ -167,7 +173,11 @@ void TableView::draw(Gfx::RendererCommands &__restrict__ cmds)
 	for(size_t i = startYCell; i < endYCell; i++)
 	{
 		auto rect = IG::makeWindowRectRel({x, y}, {viewRect().xSize(), yCellSize});
-		drawElement(cmds, i, item(*this, i), projP.unProjectRect(rect), xIndent);
+		if(auto &it = item(*this, i);
+			!it.needsCompile()) [[likely]]
+		{
+			drawElement(cmds, i, it, projP.unProjectRect(rect), xIndent);
+		}
 		y += yCellSize;
 	}
 	cmds.setClipTest(false);
@@ -178,8 +188,15 @@ void TableView::place()
 	auto cells_ = items(*this);
 	for(auto i : iotaCount(cells_))
 	{
+		auto &it = item(*this, i);
+		if(lazyItemCompile && i) // first item is always compiled for the cell size
+		{
+			it.setNeedsCompile(true);
+			continue;
+		}
 		//logMsg("compile item %d", i);
-		item(*this, i).compile(renderer(), projP);
+		it.compile(renderer(), projP);
+		it.setNeedsCompile(false);
 	}
 	if(cells_)
 	{
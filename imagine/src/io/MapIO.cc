@@ -19,6 +19,7 @@
 #include <imagine/logger/logger.h>
 #include "utils.hh"
 #include "IOUtils.hh"
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #if defined __linux__ || defined __APPLE__
@@ -58,8 +59,15 @@ std::span<uint8_t> MapIO::map()
 
 ssize_t MapIO::write(const void *buff, size_t bytes)
 {
-	// TODO
-	return -1;
+	if(!data() || this->buff.isMappedFile()) [[unlikely]]
+		return -1;
+	assert(currPos >= data());
+	if(currPos >= dataEnd())
+		return 0;
+	auto bytesToWrite = std::min(bytes, size_t(dataEnd() - currPos));
+	memcpy(currPos, buff, bytesToWrite);
+	currPos += bytesToWrite;
+	return bytesToWrite;
 }
 
 off_t MapIO::seek(off_t offset, IOSeekMode mode)
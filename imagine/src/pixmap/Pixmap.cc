@@ -13,7 +13,16 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/pixmap/Pixmap.hh>
 #include <imagine/util/container/array.hh>
+#include <imagine/util/algorithm.h>
+#if defined __x86_64__ || defined __i386__
+#include <immintrin.h>
+#define IG_PIXMAP_X86_KERNELS
+#endif
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace IG
 {
@@ -106,4 +115,277 @@ static uint32_t transformRGB888ToRGBX8888Impl(ByteArray<3> p)
 uint32_t transformRGB888ToRGBX8888(ByteArray<3> p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(ByteArray<3> p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+
+// Row conversion kernels, processing whole vectors of pixels and finishing with the scalar
+// functions. The integer math matches the scalar rounding exactly:
+// (x * k + 127) / 255 == (v + (v >> 8)) >> 8 with v = x * k + 128, for 8-bit x and k <= 63
+// (x * 255 + 15) / 31 == (x * 527 + 23) >> 6, for 5-bit x
+// (x * 255 + 31) / 63 == (x * 259 + 33) >> 6, for 6-bit x
+
+template <bool BGR_SWAP>
+static void transformRGBX8888ToRGB565Scalar(const uint32_t *src, size_t pixels, uint16_t *dest)
+{
+	transformN(src, pixels, dest, transformRGBX8888ToRGB565Impl<BGR_SWAP>);
+}
+
+template <bool BGR_SWAP>
+static void transformRGB565ToRGBX8888Scalar(const uint16_t *src, size_t pixels, uint32_t *dest)
+{
+	transformN(src, pixels, dest, transformRGB565ToRGBX8888Impl<BGR_SWAP>);
+}
+
+static void transformRGBA8888ToBGRA8888Scalar(const uint32_t *src, size_t pixels, uint32_t *dest)
+{
+	transformN(src, pixels, dest, transformRGBA8888ToBGRA8888);
+}
+
+#if defined __SSE2__
+
+static __m128i scaleTo5Or6Bits(__m128i x, short k)
+{
+	auto v = _mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(k)), _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+}
+
+static __m128i scaleFrom5Or6Bits(__m128i x, short k, short bias)
+{
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(k)), _mm_set1_epi16(bias)), 6);
+}
+
+template <bool BGR_SWAP>
+static void transformRGBX8888ToRGB565SSE2(const uint32_t *src, size_t pixels, uint16_t *dest)
+{
+	const auto byteMask = _mm_set1_epi32(0xFF);
+	for(; pixels >= 8; pixels -= 8, src += 8, dest += 8)
+	{
+		auto p0 = _mm_loadu_si128((const __m128i*)src);
+		auto p1 = _mm_loadu_si128((const __m128i*)(src + 4));
+		auto r = _mm_packs_epi32(_mm_and_si128(p0, byteMask), _mm_and_si128(p1, byteMask));
+		auto g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), byteMask), _mm_and_si128(_mm_srli_epi32(p1, 8), byteMask));
+		auto b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), byteMask), _mm_and_si128(_mm_srli_epi32(p1, 16), byteMask));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		auto out = _mm_or_si128(_mm_slli_epi16(scaleTo5Or6Bits(r, 31), 11),
+			_mm_or_si128(_mm_slli_epi16(scaleTo5Or6Bits(g, 63), 5), scaleTo5Or6Bits(b, 31)));
+		_mm_storeu_si128((__m128i*)dest, out);
+	}
+	transformRGBX8888ToRGB565Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+template <bool BGR_SWAP>
+static void transformRGB565ToRGBX8888SSE2(const uint16_t *src, size_t pixels, uint32_t *dest)
+{
+	for(; pixels >= 8; pixels -= 8, src += 8, dest += 8)
+	{
+		auto p = _mm_loadu_si128((const __m128i*)src);
+		auto r = _mm_srli_epi16(p, 11);
+		auto g = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+		auto b = _mm_and_si128(p, _mm_set1_epi16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		auto rg = _mm_or_si128(scaleFrom5Or6Bits(r, 527, 23), _mm_slli_epi16(scaleFrom5Or6Bits(g, 259, 33), 8));
+		b = scaleFrom5Or6Bits(b, 527, 23);
+		_mm_storeu_si128((__m128i*)dest, _mm_unpacklo_epi16(rg, b));
+		_mm_storeu_si128((__m128i*)(dest + 4), _mm_unpackhi_epi16(rg, b));
+	}
+	transformRGB565ToRGBX8888Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+static void transformRGBA8888ToBGRA8888SSE2(const uint32_t *src, size_t pixels, uint32_t *dest)
+{
+	for(; pixels >= 4; pixels -= 4, src += 4, dest += 4)
+	{
+		auto p = _mm_loadu_si128((const __m128i*)src);
+		auto out = _mm_or_si128(_mm_and_si128(p, _mm_set1_epi32(0xFF00FF00)),
+			_mm_or_si128(_mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xFF0000)), 16),
+				_mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xFF)), 16)));
+		_mm_storeu_si128((__m128i*)dest, out);
+	}
+	transformRGBA8888ToBGRA8888Scalar(src, pixels, dest);
+}
+
+#endif
+
+#ifdef IG_PIXMAP_X86_KERNELS
+
+[[gnu::target("avx2")]]
+static __m256i scaleTo5Or6BitsAVX2(__m256i x, short k)
+{
+	auto v = _mm256_add_epi16(_mm256_mullo_epi16(x, _mm256_set1_epi16(k)), _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), 8);
+}
+
+[[gnu::target("avx2")]]
+static __m256i scaleFrom5Or6BitsAVX2(__m256i x, short k, short bias)
+{
+	return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(x, _mm256_set1_epi16(k)), _mm256_set1_epi16(bias)), 6);
+}
+
+template <bool BGR_SWAP>
+[[gnu::target("avx2")]]
+static void transformRGBX8888ToRGB565AVX2(const uint32_t *src, size_t pixels, uint16_t *dest)
+{
+	const auto byteMask = _mm256_set1_epi32(0xFF);
+	for(; pixels >= 16; pixels -= 16, src += 16, dest += 16)
+	{
+		auto p0 = _mm256_loadu_si256((const __m256i*)src);
+		auto p1 = _mm256_loadu_si256((const __m256i*)(src + 8));
+		auto r = _mm256_packs_epi32(_mm256_and_si256(p0, byteMask), _mm256_and_si256(p1, byteMask));
+		auto g = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 8), byteMask), _mm256_and_si256(_mm256_srli_epi32(p1, 8), byteMask));
+		auto b = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 16), byteMask), _mm256_and_si256(_mm256_srli_epi32(p1, 16), byteMask));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		auto out = _mm256_or_si256(_mm256_slli_epi16(scaleTo5Or6BitsAVX2(r, 31), 11),
+			_mm256_or_si256(_mm256_slli_epi16(scaleTo5Or6BitsAVX2(g, 63), 5), scaleTo5Or6BitsAVX2(b, 31)));
+		// packs works within 128-bit lanes, restore the pixel order
+		_mm256_storeu_si256((__m256i*)dest, _mm256_permute4x64_epi64(out, 0xD8));
+	}
+	transformRGBX8888ToRGB565Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+template <bool BGR_SWAP>
+[[gnu::target("avx2")]]
+static void transformRGB565ToRGBX8888AVX2(const uint16_t *src, size_t pixels, uint32_t *dest)
+{
+	for(; pixels >= 16; pixels -= 16, src += 16, dest += 16)
+	{
+		auto p = _mm256_loadu_si256((const __m256i*)src);
+		auto r = _mm256_srli_epi16(p, 11);
+		auto g = _mm256_and_si256(_mm256_srli_epi16(p, 5), _mm256_set1_epi16(0x3F));
+		auto b = _mm256_and_si256(p, _mm256_set1_epi16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		auto rg = _mm256_or_si256(scaleFrom5Or6BitsAVX2(r, 527, 23), _mm256_slli_epi16(scaleFrom5Or6BitsAVX2(g, 259, 33), 8));
+		b = scaleFrom5Or6BitsAVX2(b, 527, 23);
+		// unpack works within 128-bit lanes, restore the pixel order
+		auto lo = _mm256_unpacklo_epi16(rg, b);
+		auto hi = _mm256_unpackhi_epi16(rg, b);
+		_mm256_storeu_si256((__m256i*)dest, _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256((__m256i*)(dest + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	transformRGB565ToRGBX8888Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+[[gnu::target("avx2")]]
+static void transformRGBA8888ToBGRA8888AVX2(const uint32_t *src, size_t pixels, uint32_t *dest)
+{
+	const auto swapMask = _mm256_setr_epi8(
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	for(; pixels >= 8; pixels -= 8, src += 8, dest += 8)
+	{
+		auto p = _mm256_loadu_si256((const __m256i*)src);
+		_mm256_storeu_si256((__m256i*)dest, _mm256_shuffle_epi8(p, swapMask));
+	}
+	transformRGBA8888ToBGRA8888Scalar(src, pixels, dest);
+}
+
+#endif
+
+#ifdef __ARM_NEON
+
+static uint16x8_t scaleTo5Or6BitsNEON(uint16x8_t x, uint16_t k)
+{
+	auto v = vmlaq_n_u16(vdupq_n_u16(128), x, k);
+	return vshrq_n_u16(vaddq_u16(v, vshrq_n_u16(v, 8)), 8);
+}
+
+static uint8x8_t scaleFrom5Or6BitsNEON(uint16x8_t x, uint16_t k, uint16_t bias)
+{
+	return vmovn_u16(vshrq_n_u16(vmlaq_n_u16(vdupq_n_u16(bias), x, k), 6));
+}
+
+template <bool BGR_SWAP>
+static uint16x8_t rgb888ToRGB565NEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	if constexpr(BGR_SWAP) { std::swap(r, b); }
+	return vorrq_u16(vshlq_n_u16(scaleTo5Or6BitsNEON(vmovl_u8(r), 31), 11),
+		vorrq_u16(vshlq_n_u16(scaleTo5Or6BitsNEON(vmovl_u8(g), 63), 5), scaleTo5Or6BitsNEON(vmovl_u8(b), 31)));
+}
+
+template <bool BGR_SWAP>
+static void transformRGBX8888ToRGB565NEON(const uint32_t *src, size_t pixels, uint16_t *dest)
+{
+	for(; pixels >= 16; pixels -= 16, src += 16, dest += 16)
+	{
+		auto p = vld4q_u8((const uint8_t*)src);
+		vst1q_u16(dest, rgb888ToRGB565NEON<BGR_SWAP>(vget_low_u8(p.val[0]), vget_low_u8(p.val[1]), vget_low_u8(p.val[2])));
+		vst1q_u16(dest + 8, rgb888ToRGB565NEON<BGR_SWAP>(vget_high_u8(p.val[0]), vget_high_u8(p.val[1]), vget_high_u8(p.val[2])));
+	}
+	transformRGBX8888ToRGB565Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+template <bool BGR_SWAP>
+static void transformRGB565ToRGBX8888NEON(const uint16_t *src, size_t pixels, uint32_t *dest)
+{
+	for(; pixels >= 8; pixels -= 8, src += 8, dest += 8)
+	{
+		auto p = vld1q_u16(src);
+		auto r = vshrq_n_u16(p, 11);
+		auto g = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+		auto b = vandq_u16(p, vdupq_n_u16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		uint8x8x4_t out{{scaleFrom5Or6BitsNEON(r, 527, 23), scaleFrom5Or6BitsNEON(g, 259, 33),
+			scaleFrom5Or6BitsNEON(b, 527, 23), vdup_n_u8(0)}};
+		vst4_u8((uint8_t*)dest, out);
+	}
+	transformRGB565ToRGBX8888Scalar<BGR_SWAP>(src, pixels, dest);
+}
+
+static void transformRGBA8888ToBGRA8888NEON(const uint32_t *src, size_t pixels, uint32_t *dest)
+{
+	for(; pixels >= 16; pixels -= 16, src += 16, dest += 16)
+	{
+		auto p = vld4q_u8((const uint8_t*)src);
+		std::swap(p.val[0], p.val[2]);
+		vst4q_u8((uint8_t*)dest, p);
+	}
+	transformRGBA8888ToBGRA8888Scalar(src, pixels, dest);
+}
+
+#endif
+
+struct RowConverters
+{
+	using RGBX8888ToRGB565Func = void(*)(const uint32_t *, size_t, uint16_t *);
+	using RGB565ToRGBX8888Func = void(*)(const uint16_t *, size_t, uint32_t *);
+	using RGBA8888ToBGRA8888Func = void(*)(const uint32_t *, size_t, uint32_t *);
+
+	RGBX8888ToRGB565Func rgbx8888ToRGB565;
+	RGBX8888ToRGB565Func bgrx8888ToRGB565;
+	RGB565ToRGBX8888Func rgb565ToRGBX8888;
+	RGB565ToRGBX8888Func rgb565ToBGRX8888;
+	RGBA8888ToBGRA8888Func rgba8888ToBGRA8888;
+};
+
+static RowConverters makeRowConverters()
+{
+	#ifdef IG_PIXMAP_X86_KERNELS
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+	{
+		return {transformRGBX8888ToRGB565AVX2<false>, transformRGBX8888ToRGB565AVX2<true>,
+			transformRGB565ToRGBX8888AVX2<false>, transformRGB565ToRGBX8888AVX2<true>,
+			transformRGBA8888ToBGRA8888AVX2};
+	}
+	#endif
+	#if defined __SSE2__
+	return {transformRGBX8888ToRGB565SSE2<false>, transformRGBX8888ToRGB565SSE2<true>,
+		transformRGB565ToRGBX8888SSE2<false>, transformRGB565ToRGBX8888SSE2<true>,
+		transformRGBA8888ToBGRA8888SSE2};
+	#elif defined __ARM_NEON
+	return {transformRGBX8888ToRGB565NEON<false>, transformRGBX8888ToRGB565NEON<true>,
+		transformRGB565ToRGBX8888NEON<false>, transformRGB565ToRGBX8888NEON<true>,
+		transformRGBA8888ToBGRA8888NEON};
+	#else
+	return {transformRGBX8888ToRGB565Scalar<false>, transformRGBX8888ToRGB565Scalar<true>,
+		transformRGB565ToRGBX8888Scalar<false>, transformRGB565ToRGBX8888Scalar<true>,
+		transformRGBA8888ToBGRA8888Scalar};
+	#endif
+}
+
+static const RowConverters rowConverters = makeRowConverters();
+
+void transformRGBX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest) { rowConverters.rgbx8888ToRGB565(src, pixels, dest); }
+void transformBGRX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest) { rowConverters.bgrx8888ToRGB565(src, pixels, dest); }
+void transformRGB565ToRGBX8888N(const uint16_t *src, size_t pixels, uint32_t *dest) { rowConverters.rgb565ToRGBX8888(src, pixels, dest); }
+void transformRGB565ToBGRX8888N(const uint16_t *src, size_t pixels, uint32_t *dest) { rowConverters.rgb565ToBGRX8888(src, pixels, dest); }
+void transformRGBA8888ToBGRA8888N(const uint32_t *src, size_t pixels, uint32_t *dest) { rowConverters.rgba8888ToBGRA8888(src, pixels, dest); }
+
 }
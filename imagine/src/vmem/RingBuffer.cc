@@ -146,6 +146,15 @@ void RingBuffer::commitWrite(SizeType size)
 	written.fetch_add(size, std::memory_order_release);
 }
 
+void RingBuffer::uncommitWrite(SizeType size_)
+{
+	// drop the most recently written bytes, the data stays readable from writeAddr() until overwritten
+	assert(size_ <= size());
+	SizeType endOffset = end - buff;
+	end = endOffset >= size_ ? end - size_ : end + (buffSize - size_);
+	written.fetch_sub(size_, std::memory_order_release);
+}
+
 SizeType RingBuffer::read(void *buff, SizeType size_)
 {
 	auto writtenSize = size();
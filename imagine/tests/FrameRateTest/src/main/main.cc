@@ -76,12 +76,15 @@ FrameRateTestApplication::FrameRateTestApplication(IG::ApplicationInitParams ini
 			std::vector<TestDesc> testDesc;
 			testDesc.emplace_back(TEST_CLEAR, "Clear");
 			IG::WP pixmapSize{256, 256};
+			IG::WP convertPixmapSize{704, 512};
 			for(auto desc: renderer.textureBufferModes())
 			{
 				testDesc.emplace_back(TEST_DRAW, fmt::format("Draw RGB565 {}x{} ({})", pixmapSize.x, pixmapSize.y, desc.name),
 					pixmapSize, desc.mode);
 				testDesc.emplace_back(TEST_WRITE, fmt::format("Write RGB565 {}x{} ({})", pixmapSize.x, pixmapSize.y, desc.name),
 					pixmapSize, desc.mode);
+				testDesc.emplace_back(TEST_CONVERT, fmt::format("Convert RGBA8888 To RGB565 {}x{} ({})", convertPixmapSize.x, convertPixmapSize.y, desc.name),
+					convertPixmapSize, desc.mode);
 			}
 			auto &picker = winData.picker;
 			picker.setTests(testDesc.data(), testDesc.size());
@@ -312,6 +315,7 @@ TestFramework *FrameRateTestApplication::startTest(IG::Window &win, const TestPa
 			case TEST_CLEAR: return std::make_unique<ClearTest>();
 			case TEST_DRAW: return std::make_unique<DrawTest>();
 			case TEST_WRITE: return std::make_unique<WriteTest>();
+			case TEST_CONVERT: return std::make_unique<ConvertTest>();
 		}
 		bug_unreachable("invalid TestID");
 	}();
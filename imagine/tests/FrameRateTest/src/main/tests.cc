@@ -37,6 +37,7 @@ const char *testIDToStr(TestID id)
 		case TEST_CLEAR: return "Clear";
 		case TEST_DRAW: return "Draw";
 		case TEST_WRITE: return "Write";
+		case TEST_CONVERT: return "Convert";
 		default: return "Unknown";
 	}
 }
@@ -147,6 +148,11 @@ void TestFramework::frameUpdate(Gfx::RendererTask &rTask, IG::Window &win, IG::F
 				(unsigned long)std::chrono::duration_cast<IG::Milliseconds>(lastFramePresentTime.atWinPresent - lastFramePresentTime.atOnFrame).count(),
 				lostFrameProcessTime,
 				(unsigned long)std::chrono::duration_cast<IG::Milliseconds>(timestamp - lastFramePresentTime.timestamp).count());
+			if(testStatsStr.size())
+			{
+				statsStr += '\n';
+				statsStr += testStatsStr;
+			}
 			updatedFrameStats = true;
 		}
 		if(updatedFrameStats)
@@ -321,4 +327,37 @@ void WriteTest::drawTest(Gfx::RendererCommands &cmds, Gfx::ClipRect bounds)
 	sprite.draw(cmds, cmds.basicEffect());
 }
 
+void ConvertTest::initTest(IG::ApplicationContext app, Gfx::Renderer &r, IG::WP pixmapSize, Gfx::TextureBufferMode bufferMode)
+{
+	DrawTest::initTest(app, r, pixmapSize, bufferMode);
+	srcPixmap = {{pixmapSize, IG::PIXEL_FMT_RGBA8888}};
+	auto pix = srcPixmap.view();
+	for(auto y : iotaCount(pix.h()))
+	{
+		for(auto x : iotaCount(pix.w()))
+		{
+			((uint32_t*)pix.data())[y * pix.pitchPixels() + x] = IG::PIXEL_DESC_RGBA8888.build(
+				x / (float)pix.w(), y / (float)pix.h(), .5f, 1.f);
+		}
+	}
+}
+
+void ConvertTest::frameUpdateTest(Gfx::RendererTask &rendererTask, IG::Screen &, IG::FrameTime)
+{
+	rendererTask.clientWaitSync(std::exchange(presentFence, {}));
+	auto lockedBuff = texture.lock();
+	auto startTime = IG::steadyClockTimestamp();
+	lockedBuff.pixmap().writeConverted(srcPixmap.view());
+	convertTime += IG::steadyClockTimestamp() - startTime;
+	texture.unlock(lockedBuff);
+	if(++convertFrames == 60)
+	{
+		testStatsStr.clear();
+		IG::formatTo(testStatsStr, "RGBA8888 -> RGB565 Time: {:.3f}ms",
+			IG::FloatSeconds(convertTime).count() * 1000. / convertFrames);
+		convertTime = {};
+		convertFrames = 0;
+	}
+}
+
 }
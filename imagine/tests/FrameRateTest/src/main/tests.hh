@@ -20,6 +20,7 @@
 #include <imagine/gfx/ProjectionPlane.hh>
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
+#include <imagine/pixmap/MemPixmap.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/thread/Semaphore.hh>
 #include <imagine/base/ApplicationContext.hh>
@@ -39,6 +40,7 @@ enum TestID
 	TEST_CLEAR,
 	TEST_DRAW,
 	TEST_WRITE,
+	TEST_CONVERT,
 };
 
 struct FramePresentTime
@@ -110,6 +112,7 @@ protected:
 	std::string cpuUseStr{};
 	std::string skippedFrameStr{};
 	std::string statsStr{};
+	std::string testStatsStr{};
 	Gfx::GCRect cpuStatsRect{};
 	Gfx::GCRect frameStatsRect{};
 	Gfx::ProjectionPlane projP;
@@ -150,6 +153,18 @@ public:
 	void drawTest(Gfx::RendererCommands &cmds, Gfx::ClipRect bounds) override;
 };
 
+class ConvertTest : public WriteTest
+{
+protected:
+	IG::MemPixmap srcPixmap;
+	IG::Time convertTime{};
+	unsigned convertFrames{};
+
+public:
+	void initTest(IG::ApplicationContext, Gfx::Renderer &, IG::WP pixmapSize, Gfx::TextureBufferMode) override;
+	void frameUpdateTest(Gfx::RendererTask &rendererTask, IG::Screen &screen, IG::FrameTime frameTime) override;
+};
+
 const char *testIDToStr(TestID id);
 
 }